@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2014, Julien Bernard
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+#include <ui/Callback.h>
+
+// compare ui::Callback with std::function for the callbacks of the widgets:
+// binding a lambda (what setCallback() does when a row is recycled) and
+// invoking it (what onPrimaryAction() does)
+
+static constexpr std::size_t Count = 1000;
+static constexpr int Rounds = 10000;
+
+typedef std::chrono::steady_clock Clock;
+
+static double getNanoseconds(Clock::time_point start, Clock::time_point end) {
+  return std::chrono::duration<double, std::nano>(end - start).count() / (static_cast<double>(Count) * Rounds);
+}
+
+template<typename Holder>
+static void bench(const char *name, unsigned long& counter) {
+  std::vector<Holder> small(Count);
+  std::vector<Holder> large(Count);
+  unsigned long *p = &counter;
+
+  auto start = Clock::now();
+
+  for (int round = 0; round < Rounds; ++round) {
+    for (std::size_t i = 0; i < Count; ++i) {
+      // like the [this, i] lambdas of the examples
+      small[i] = [p, i]() { *p += i; };
+    }
+  }
+
+  auto end = Clock::now();
+  double small_binding = getNanoseconds(start, end);
+
+  start = Clock::now();
+
+  for (int round = 0; round < Rounds; ++round) {
+    for (std::size_t i = 0; i < Count; ++i) {
+      // too large for the small buffer of std::function
+      unsigned long *q = p;
+      std::size_t j = i + 1, k = i + 2;
+      large[i] = [p, q, i, j, k]() { *p += i; *q += j ^ k; };
+    }
+  }
+
+  end = Clock::now();
+  double large_binding = getNanoseconds(start, end);
+
+  start = Clock::now();
+
+  for (int round = 0; round < Rounds; ++round) {
+    for (auto& callback : small) {
+      callback();
+    }
+  }
+
+  end = Clock::now();
+  double small_invocation = getNanoseconds(start, end);
+
+  start = Clock::now();
+
+  for (int round = 0; round < Rounds; ++round) {
+    for (auto& callback : large) {
+      callback();
+    }
+  }
+
+  end = Clock::now();
+  double large_invocation = getNanoseconds(start, end);
+
+  std::printf("%-22s bind %6.2f ns (large %6.2f ns), invoke %5.2f ns (large %5.2f ns)\n", name, small_binding, large_binding, small_invocation, large_invocation);
+}
+
+int main() {
+  unsigned long counter = 0;
+
+  bench<std::function<void()>>("std::function<void()>", counter);
+  bench<ui::Callback>("ui::Callback", counter);
+
+  // the counter is printed so that the calls are not optimized out
+  std::printf("(%lu)\n", counter);
+  return 0;
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2014, Julien Bernard
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#include <cstdio>
+#include <ctime>
+#include <memory>
+#include <string>
+
+#include <SFML/Graphics.hpp>
+
+#include <ui/Action.h>
+#include <ui/Area.h>
+#include <ui/Button.h>
+#include <ui/Form.h>
+#include <ui/Label.h>
+#include <ui/MainLoop.h>
+
+#include "common/WidgetRenderer.h"
+
+// measure the CPU used by a static menu that nobody touches, first with the
+// loop the examples had before MainLoop (poll the events and draw at each
+// iteration) during a fixed time, then with MainLoop (wait for the events,
+// draw when damaged) until the window is closed
+
+static const sf::Time Duration = sf::seconds(5.0f);
+
+static double getCpuSeconds() {
+  // the processor time of the process
+  return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+}
+
+static void report(const char *name, sf::Time wall, double cpu, std::size_t draws) {
+  double seconds = wall.asSeconds();
+  std::printf("%-8s %5.2f s, cpu %5.2f s (%5.1f %%), %zu draws\n", name, seconds, cpu, 100.0 * cpu / seconds, draws);
+}
+
+int main() {
+  sf::RenderWindow window(sf::VideoMode(800, 600), "libsuit: idle CPU of a static menu");
+  WidgetRenderer renderer(window);
+
+  if (!renderer.hasFont()) {
+    return 1;
+  }
+
+  ui::Area area(800.0f, 600.0f);
+  auto form = new ui::Form;
+
+  for (int i = 0; i < 10; ++i) {
+    form->addRow(new ui::Label("Option " + std::to_string(i)), new ui::Button("Change"));
+  }
+
+  area.addChild(form);
+  area.updateLayout();
+
+  ui::StandardActionSet actions;
+
+  // before: the loop never sleeps
+  sf::Clock clock;
+  double cpu_start = getCpuSeconds();
+  std::size_t draws = 0;
+
+  while (window.isOpen() && clock.getElapsedTime() < Duration) {
+    sf::Event event;
+
+    while (window.pollEvent(event)) {
+      actions.update(event);
+    }
+
+    actions.handleArea(area);
+
+    window.clear(sf::Color::White);
+    renderer.draw(area);
+    window.display();
+    draws++;
+
+    actions.reset();
+  }
+
+  report("polling", clock.getElapsedTime(), getCpuSeconds() - cpu_start, draws);
+
+  // after: the loop blocks in waitEvent(), so nothing must wake it up, not
+  // even a timer; the window is closed from outside, by hand or by a
+  // script (for example `wmctrl -c`)
+  auto close_action = std::make_shared<ui::Action>("Close");
+  close_action->addCloseControl();
+  actions.addAction(close_action);
+
+  ui::MainLoop loop(window, area, actions);
+
+  loop.setUpdateCallback([&]() {
+    if (close_action->isActive()) {
+      window.close();
+    }
+  });
+
+  loop.setDrawCallback([&]() {
+    window.clear(sf::Color::White);
+    renderer.draw(area);
+  });
+
+  std::printf("Close the window to stop the measure of MainLoop.\n");
+
+  clock.restart();
+  cpu_start = getCpuSeconds();
+
+  loop.run();
+
+  report("MainLoop", clock.getElapsedTime(), getCpuSeconds() - cpu_start, loop.getDrawCount());
+  std::printf("MainLoop: %zu iterations, %.2f s idle\n", loop.getIterationCount(), loop.getIdleTime().asSeconds());
+  return 0;
+}
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2014, Julien Bernard
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include <ui/Area.h>
+#include <ui/Button.h>
+#include <ui/HBox.h>
+#include <ui/VBox.h>
+#include <ui/WidgetVisitor.h>
+
+// compare the navigation graph of the area with the linear scan it replaced:
+// before, each key press visited the whole hierarchy and looked at all the
+// focusable widgets to find the closest one in the direction
+
+typedef std::chrono::steady_clock Clock;
+
+enum Direction {
+  Up,
+  Down,
+  Left,
+  Right,
+};
+
+class LinearNavigation : public ui::WidgetVisitor {
+public:
+  virtual void visitArea(ui::Area& widget) override {
+    visitStackTopChild(widget);
+  }
+
+  virtual void visitHBox(ui::HBox& widget) override {
+    visitContainerChildren(widget);
+  }
+
+  virtual void visitVBox(ui::VBox& widget) override {
+    visitContainerChildren(widget);
+  }
+
+  virtual void visitButton(ui::Button& widget) override {
+    if (widget.isFocusable()) {
+      focusable.push_back(&widget);
+    }
+
+    if (widget.isFocused()) {
+      focused = &widget;
+    }
+  }
+
+  void navigate(Direction direction) {
+    if (focused == nullptr) {
+      return;
+    }
+
+    sf::Vector2f center = focused->getCenter();
+    ui::Leaf *next = nullptr;
+    float next_distance = 0.0f;
+
+    for (auto leaf : focusable) {
+      sf::Vector2f other = leaf->getCenter();
+      float dx = other.x - center.x;
+      float dy = other.y - center.y;
+      bool ok = false;
+
+      switch (direction) {
+        case Up:
+          ok = dy < 0 && std::abs(dx) <= std::abs(dy);
+          break;
+        case Down:
+          ok = dy > 0 && std::abs(dx) <= std::abs(dy);
+          break;
+        case Left:
+          ok = dx < 0 && std::abs(dx) >= std::abs(dy);
+          break;
+        case Right:
+          ok = dx > 0 && std::abs(dx) >= std::abs(dy);
+          break;
+      }
+
+      float distance = dx * dx + dy * dy;
+
+      if (ok && (next == nullptr || distance < next_distance)) {
+        next = leaf;
+        next_distance = distance;
+      }
+    }
+
+    if (next != nullptr) {
+      focused->setFocused(false);
+      next->setFocused(true);
+    }
+  }
+
+  std::vector<ui::Leaf*> focusable;
+  ui::Leaf *focused = nullptr;
+};
+
+static ui::Area *createGrid(int side) {
+  auto area = new ui::Area(side * 40.0f, side * 20.0f);
+  auto rows = new ui::VBox;
+  rows->setSizePolicy(ui::SizePolicy::MINIMUM, ui::SizePolicy::MINIMUM);
+
+  for (int i = 0; i < side; ++i) {
+    auto row = new ui::HBox;
+    row->setSizePolicy(ui::SizePolicy::MINIMUM, ui::SizePolicy::MINIMUM);
+
+    for (int j = 0; j < side; ++j) {
+      auto button = new ui::Button("");
+      button->setSizePolicy(ui::SizePolicy::MINIMUM, ui::SizePolicy::MINIMUM);
+      row->addChild(button);
+    }
+
+    rows->addChild(row);
+  }
+
+  area->addChild(rows);
+  area->updateLayout();
+  return area;
+}
+
+// go around the grid: right, down, left, up
+static Direction getDirection(int press, int side) {
+  static const Direction directions[] = { Right, Down, Left, Up };
+  return directions[(press / (side - 1)) % 4];
+}
+
+static void navigateGraph(ui::Area& area, Direction direction) {
+  switch (direction) {
+    case Up:
+      area.onUp();
+      break;
+    case Down:
+      area.onDown();
+      break;
+    case Left:
+      area.onLeft();
+      break;
+    case Right:
+      area.onRight();
+      break;
+  }
+}
+
+static double getMicroseconds(Clock::time_point start, Clock::time_point end, int count) {
+  return std::chrono::duration<double, std::micro>(end - start).count() / count;
+}
+
+int main() {
+  static constexpr int Presses = 4000;
+  bool ok = true;
+
+  std::printf("%8s %10s %14s %14s %14s\n", "widgets", "presses", "graph build", "graph press", "linear press");
+
+  for (int side : { 10, 30, 100, 200 }) {
+    std::unique_ptr<ui::Area> graph_area(createGrid(side));
+    std::unique_ptr<ui::Area> linear_area(createGrid(side));
+
+    // the first press focuses the first widget, the second one builds the
+    // graph
+    graph_area->onRight();
+
+    auto start = Clock::now();
+    graph_area->onRight();
+    auto end = Clock::now();
+    double build = getMicroseconds(start, end, 1);
+
+    start = Clock::now();
+
+    for (int press = 1; press < Presses; ++press) {
+      navigateGraph(*graph_area, getDirection(press, side));
+    }
+
+    end = Clock::now();
+    double graph = getMicroseconds(start, end, Presses - 1);
+
+    linear_area->onRight();
+    linear_area->onRight();
+
+    start = Clock::now();
+
+    for (int press = 1; press < Presses; ++press) {
+      LinearNavigation navigation;
+      navigation.visitArea(*linear_area);
+      navigation.navigate(getDirection(press, side));
+    }
+
+    end = Clock::now();
+    double linear = getMicroseconds(start, end, Presses - 1);
+
+    // both navigations must end on the same widget
+    sf::Vector2f graph_center = graph_area->getFocused()->getCenter();
+    sf::Vector2f linear_center = linear_area->getFocused()->getCenter();
+
+    if (graph_center != linear_center) {
+      std::fprintf(stderr, "Error! The navigations differ for %d widgets.\n", side * side);
+      ok = false;
+    }
+
+    std::printf("%8d %10d %11.1f us %11.2f us %11.2f us\n", side * side, Presses, build, graph, linear);
+  }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2014, Julien Bernard
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include <SFML/Graphics.hpp>
+
+#include <ui/Area.h>
+#include <ui/Button.h>
+#include <ui/Form.h>
+#include <ui/Label.h>
+#include <ui/RenderCommandList.h>
+#include <ui/RenderVisitor.h>
+
+#include "common/FontCache.h"
+#include "common/WidgetRenderer.h"
+
+// measure the draw calls and the frame time of WidgetRenderer on a form with
+// many texts, and compare with drawing each command on its own, like
+// WidgetRenderer did before the boxes and the glyphs were batched
+
+static constexpr int Rows = 40;
+static constexpr int Frames = 500;
+static constexpr unsigned Width = 800;
+static constexpr unsigned Height = 2400;
+
+typedef std::chrono::steady_clock Clock;
+
+// one draw call for each box, each outline and each text
+static std::size_t drawEachCommand(sf::RenderTarget& target, const ui::RenderCommandList& commands, const sf::Font& font) {
+  std::size_t draw_calls = 0;
+
+  for (auto& command : commands) {
+    const sf::FloatRect& geometry = command.geometry;
+
+    switch (command.type) {
+      case ui::RenderCommandType::RECTANGLE: {
+        sf::RectangleShape shape({ geometry.width, geometry.height });
+        shape.setPosition(geometry.left, geometry.top);
+        shape.setFillColor(command.color);
+        target.draw(shape);
+        draw_calls++;
+        break;
+      }
+      case ui::RenderCommandType::OUTLINE: {
+        sf::RectangleShape shape({ geometry.width, geometry.height });
+        shape.setPosition(geometry.left, geometry.top);
+        shape.setFillColor(sf::Color::Transparent);
+        shape.setOutlineColor(command.color);
+        shape.setOutlineThickness(1.0f);
+        target.draw(shape);
+        draw_calls++;
+        break;
+      }
+      case ui::RenderCommandType::TEXT: {
+        sf::Text text(std::string(commands.getText(command), command.text_length), font, 16);
+        sf::FloatRect bounds = text.getLocalBounds();
+        text.setPosition(geometry.left + (geometry.width - bounds.width) / 2, geometry.top + (geometry.height - bounds.height) / 2);
+        text.setColor(command.color);
+        target.draw(text);
+        draw_calls++;
+        break;
+      }
+      default:
+        // no clip nor cache in the form
+        break;
+    }
+  }
+
+  return draw_calls;
+}
+
+static double getMilliseconds(Clock::time_point start, Clock::time_point end) {
+  return std::chrono::duration<double, std::milli>(end - start).count() / Frames;
+}
+
+int main() {
+  sf::RenderTexture target;
+
+  if (!target.create(Width, Height)) {
+    std::fprintf(stderr, "Error! Could not create the render texture.\n");
+    return 1;
+  }
+
+  auto font = FontCache::getFont(DEFAULT_FONT);
+
+  if (!font) {
+    return 1;
+  }
+
+  ui::Area area(static_cast<float>(Width), static_cast<float>(Height));
+  auto form = new ui::Form;
+
+  for (int i = 0; i < Rows; ++i) {
+    form->addRow(new ui::Label("Setting number " + std::to_string(i)), new ui::Button("Value of the setting " + std::to_string(i)));
+  }
+
+  area.addChild(form);
+  area.updateLayout();
+
+  // one command per box, outline and text, drawn on its own
+  ui::RenderCommandList commands;
+  sf::FloatRect visible(0.0f, 0.0f, static_cast<float>(Width), static_cast<float>(Height));
+  std::size_t each_draw_calls = 0;
+
+  auto start = Clock::now();
+
+  for (int frame = 0; frame < Frames; ++frame) {
+    target.clear(sf::Color::White);
+    commands.clear();
+    ui::RenderVisitor visitor(commands);
+    visitor.setClip(&visible);
+    area.accept(visitor);
+    each_draw_calls = drawEachCommand(target, commands, *font);
+    target.display();
+  }
+
+  auto end = Clock::now();
+  double each_time = getMilliseconds(start, end);
+
+  // the boxes in one vertex array, the glyphs in another one
+  WidgetRenderer renderer(target);
+  std::size_t batched_draw_calls = 0;
+
+  start = Clock::now();
+
+  for (int frame = 0; frame < Frames; ++frame) {
+    target.clear(sf::Color::White);
+    renderer.draw(area);
+    batched_draw_calls = renderer.getDrawCallCount();
+    target.display();
+  }
+
+  end = Clock::now();
+  double batched_time = getMilliseconds(start, end);
+
+  std::printf("%d rows, %zu commands, %d frames\n", Rows, commands.getCommandCount(), Frames);
+  std::printf("%-16s %10s %12s\n", "renderer", "draw calls", "frame time");
+  std::printf("%-16s %10zu %9.3f ms\n", "each command", each_draw_calls, each_time);
+  std::printf("%-16s %10zu %9.3f ms\n", "WidgetRenderer", batched_draw_calls, batched_time);
+  return 0;
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2014, Julien Bernard
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#include <cstdlib>
+#include <iostream>
+
+#include <ui/Area.h>
+#include <ui/Bin.h>
+#include <ui/Toggle.h>
+#include <ui/VBox.h>
+
+// check that changing the widgets of the hierarchy damages the area, even
+// when the new widgets have the same geometry as the previous ones
+
+static ui::Widget *createPanel() {
+  auto panel = new ui::VBox;
+  panel->setSizePolicy(ui::SizePolicy::MINIMUM, ui::SizePolicy::MINIMUM);
+
+  for (int i = 0; i < 3; ++i) {
+    panel->addChild(new ui::Toggle);
+  }
+
+  return panel;
+}
+
+static bool check(ui::Area& area, const char *what) {
+  area.updateLayout();
+
+  if (!area.isDamaged()) {
+    std::cerr << "Error! " << what << " does not damage the area.\n";
+    return false;
+  }
+
+  area.clearDamage();
+  return true;
+}
+
+int main() {
+  bool ok = true;
+
+  ui::Area area(800.0f, 600.0f);
+  area.addChild(createPanel());
+  area.updateLayout();
+  area.clearDamage();
+
+  // a dialog on top of the panel, with the same geometry
+  area.addChild(createPanel());
+  ok = check(area, "pushing a child on a stack") && ok;
+
+  area.removeChild();
+  ok = check(area, "popping a child from a stack") && ok;
+
+  auto bin = new ui::Bin;
+  bin->setSizePolicy(ui::SizePolicy::MINIMUM, ui::SizePolicy::MINIMUM);
+  bin->setChild(createPanel());
+  area.addChild(bin);
+  area.updateLayout();
+  area.clearDamage();
+
+  // the previous child is not owned by the bin
+  ui::Widget *previous = bin->getChild();
+  bin->setChild(createPanel());
+  delete previous;
+  ok = check(area, "replacing the child of a bin") && ok;
+
+  if (!ok) {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Damage checks passed.\n";
+  return EXIT_SUCCESS;
+}
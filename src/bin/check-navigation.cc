@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2014, Julien Bernard
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include <ui/Area.h>
+#include <ui/Button.h>
+#include <ui/ScrollArea.h>
+#include <ui/VBox.h>
+
+// check that the keyboard navigation reaches the leaves of a scroll area
+// that are outside the scroll area at first
+
+static constexpr int Count = 30;
+
+int main() {
+  ui::Area area(400.0f, 300.0f);
+
+  auto box = new ui::VBox;
+  ui::Button *first = nullptr;
+  ui::Button *last = nullptr;
+
+  for (int i = 0; i < Count; ++i) {
+    last = new ui::Button("Button " + std::to_string(i));
+    last->setSizeHint(300.0f, 40.0f);
+    box->addChild(last);
+
+    if (first == nullptr) {
+      first = last;
+    }
+  }
+
+  auto scroll = new ui::ScrollArea;
+  scroll->setChild(box);
+  area.addChild(scroll);
+  area.updateLayout();
+
+  bool ok = true;
+
+  for (int i = 0; i < Count + 10; ++i) {
+    area.onDown();
+    area.updateLayout();
+  }
+
+  if (area.getFocused() != last) {
+    std::cerr << "Error! The last leaf of the scroll area can not be reached.\n";
+    ok = false;
+  }
+
+  for (int i = 0; i < Count + 10; ++i) {
+    area.onUp();
+    area.updateLayout();
+  }
+
+  if (area.getFocused() != first || scroll->getOffset().y != 0.0f) {
+    std::cerr << "Error! The first leaf of the scroll area can not be reached again.\n";
+    ok = false;
+  }
+
+  if (!ok) {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Navigation checks passed.\n";
+  return EXIT_SUCCESS;
+}
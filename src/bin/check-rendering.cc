@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2014, Julien Bernard
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+#include <ui/Area.h>
+#include <ui/Form.h>
+#include <ui/Label.h>
+#include <ui/ScrollArea.h>
+#include <ui/SoftwareRenderer.h>
+#include <ui/Toggle.h>
+#include <ui/VBox.h>
+
+// check the pixels drawn by the software renderer: the fill and the outline
+// of a widget, and the clipping of the content of a scroll area
+
+static constexpr unsigned Width = 400;
+static constexpr unsigned Height = 300;
+
+static const sf::Color Background(0x00, 0x00, 0xFF);
+static const sf::Color Selected(0x80, 0x80, 0x80);
+
+static bool check(const ui::SoftwareRenderer& renderer, float x, float y, const sf::Color& expected, const char *what) {
+  unsigned px = static_cast<unsigned>(std::floor(x));
+  unsigned py = static_cast<unsigned>(std::floor(y));
+  sf::Color actual = renderer.getPixel(px, py);
+
+  if (actual != expected) {
+    std::cerr << "Error! " << what << ": pixel (" << px << ", " << py << ") is ("
+        << int(actual.r) << ", " << int(actual.g) << ", " << int(actual.b) << ", " << int(actual.a) << ").\n";
+    return false;
+  }
+
+  return true;
+}
+
+static ui::Toggle *createToggle(bool selected) {
+  auto toggle = new ui::Toggle;
+  toggle->setSizeHint(100.0f, 40.0f);
+
+  if (selected) {
+    toggle->setSelected();
+  }
+
+  return toggle;
+}
+
+int main() {
+  ui::Area area(static_cast<float>(Width), static_cast<float>(Height));
+  auto box = new ui::VBox;
+
+  // a form on top, with a toggle that is not selected
+  auto form = new ui::Form;
+  auto form_toggle = createToggle(false);
+  form->addRow(new ui::Label("Option"), form_toggle);
+  box->addChild(form);
+
+  // a scroll area below, with selected toggles, the first one partially
+  // scrolled out
+  auto content = new ui::VBox;
+  ui::Toggle *first = nullptr;
+
+  for (int i = 0; i < 10; ++i) {
+    auto toggle = createToggle(true);
+    content->addChild(toggle);
+
+    if (first == nullptr) {
+      first = toggle;
+    }
+  }
+
+  auto scroll = new ui::ScrollArea;
+  scroll->setChild(content);
+  box->addChild(scroll);
+
+  area.addChild(box);
+  area.updateLayout();
+  scroll->setOffset({ 0.0f, 15.0f });
+
+  ui::SoftwareRenderer renderer(Width, Height);
+  renderer.clear(Background);
+  renderer.draw(area);
+
+  bool ok = true;
+
+  sf::FloatRect toggle = form_toggle->getGeometry();
+  float center_x = toggle.left + toggle.width / 2;
+  float center_y = toggle.top + toggle.height / 2;
+  ok = check(renderer, center_x, center_y, sf::Color::White, "the fill of a toggle") && ok;
+  ok = check(renderer, toggle.left - 1.0f, center_y, sf::Color::Black, "the left outline of a toggle") && ok;
+  ok = check(renderer, center_x, toggle.top + toggle.height, sf::Color::Black, "the bottom outline of a toggle") && ok;
+
+  // the first toggle is drawn inside the scroll area, and not above
+  sf::FloatRect viewport = scroll->getGeometry();
+  sf::FloatRect shown = first->getGeometry();
+  center_x = shown.left + shown.width / 2;
+
+  if (shown.top - scroll->getOffset().y >= viewport.top) {
+    std::cerr << "Error! The first toggle is not scrolled out.\n";
+    ok = false;
+  }
+
+  ok = check(renderer, center_x, viewport.top + 1.0f, Selected, "the visible part of a scrolled toggle") && ok;
+
+  if (renderer.getPixel(static_cast<unsigned>(center_x), static_cast<unsigned>(viewport.top) - 1) == Selected) {
+    std::cerr << "Error! The content of the scroll area is drawn above the scroll area.\n";
+    ok = false;
+  }
+
+  if (!ok) {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Rendering checks passed.\n";
+  return EXIT_SUCCESS;
+}
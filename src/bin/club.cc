@@ -20,6 +20,7 @@
 
 #include <ui/Action.h>
 #include <ui/Area.h>
+#include <ui/MainLoop.h>
 #include <ui/VideoConfigWidget.h>
 
 #include "common/WidgetRenderer.h"
@@ -42,29 +43,20 @@ int main() {
   escapeAction->addCloseControl();
   actions.addAction(escapeAction);
 
-  while (window.isOpen()) {
-
-    sf::Event event;
-    while (window.pollEvent(event)) {
-      actions.update(event);
-
-      if (event.type == sf::Event::MouseButtonPressed) {
-        area.onClick(event.mouseButton.button, { static_cast<float>(event.mouseButton.x), static_cast<float>(event.mouseButton.y) });
-      }
-    }
+  ui::MainLoop loop(window, area, actions);
 
+  loop.setUpdateCallback([&]() {
     if (escapeAction->isActive()) {
       window.close();
     }
+  });
 
-    actions.handleArea(area);
-
+  loop.setDrawCallback([&]() {
     window.clear(sf::Color::White);
     renderer.draw(area, false);
-    window.display();
+  });
 
-    actions.reset();
-  }
+  loop.run();
 
   return 0;
 }
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2014, Julien Bernard
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#include "FontCache.h"
+
+#include <iostream>
+
+std::mutex FontCache::s_mutex;
+std::map<std::string, std::weak_ptr<sf::Font>> FontCache::s_fonts;
+
+std::shared_ptr<sf::Font> FontCache::getFont(const std::string& filename) {
+  std::lock_guard<std::mutex> lock(s_mutex);
+
+  // the font is shared as long as someone uses it
+  auto font = s_fonts[filename].lock();
+
+  if (font) {
+    return font;
+  }
+
+  font = std::make_shared<sf::Font>();
+
+  if (!font->loadFromFile(filename)) {
+    // a failure is not cached, the next call tries again
+    std::cerr << "Error loading font: " << filename << std::endl;
+    return nullptr;
+  }
+
+  s_fonts[filename] = font;
+  return font;
+}
+
+void FontCache::prewarm(const sf::Font& font, const std::string& characters, unsigned size) {
+  sf::String string(characters);
+
+  for (std::size_t i = 0; i < string.getSize(); ++i) {
+    font.getGlyph(string[i], size, false);
+  }
+}
+
+const char *FontCache::getDefaultCharacters() {
+  return
+    " !\"#$%&'()*+,-./0123456789:;<=>?@"
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`"
+    "abcdefghijklmnopqrstuvwxyz{|}~";
+}
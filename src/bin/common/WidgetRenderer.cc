@@ -15,18 +15,40 @@
  */
 #include "WidgetRenderer.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 #include <ui/DebugVisitor.h>
+#include <ui/RenderVisitor.h>
+
+#include "FontCache.h"
 
 #define CHARACTER_SIZE 16
 
+static void appendQuad(sf::VertexArray& vertices, float left, float top, float width, float height, const sf::Color& color) {
+  vertices.append(sf::Vertex({ left, top }, color));
+  vertices.append(sf::Vertex({ left + width, top }, color));
+  vertices.append(sf::Vertex({ left + width, top + height }, color));
+  vertices.append(sf::Vertex({ left, top + height }, color));
+}
+
 WidgetRenderer::WidgetRenderer(sf::RenderTarget& target)
 : m_target(target)
+, m_font(FontCache::getFont(DEFAULT_FONT))
+, m_boxes(sf::Quads)
+, m_glyphs(sf::Quads)
+, m_text_count(0)
+, m_frame(0)
+, m_draw_calls(0)
+, m_culled_count(0)
 {
-  if (!m_font.loadFromFile("/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf")) {
-    std::cerr << "Error loading font!" << std::endl;
+  if (!m_font) {
+    return;
   }
+
+  // rasterize the common glyphs now rather than during the first frame
+  FontCache::prewarm(*m_font, FontCache::getDefaultCharacters(), CHARACTER_SIZE);
 }
 
 void WidgetRenderer::draw(ui::Widget& widget, bool debug) {
@@ -35,7 +57,8 @@ void WidgetRenderer::draw(ui::Widget& widget, bool debug) {
   auto size = m_target.getSize();
   m_target.setView(sf::View({ 0, 0, static_cast<float>(size.x), static_cast<float>(size.y)}));
 
-  widget.accept(*this);
+  m_draw_calls = 0;
+  render(widget);
 
   if (debug) {
     ui::DebugVisitor visitor(m_target);
@@ -45,142 +68,438 @@ void WidgetRenderer::draw(ui::Widget& widget, bool debug) {
   m_target.setView(saved_view);
 }
 
+void WidgetRenderer::drawDamage(ui::Area& area, const sf::Color& background) {
+  sf::View saved_view = m_target.getView();
 
-void WidgetRenderer::visitArea(ui::Area& widget) {
-  visitStackTopChild(widget);
-}
+  auto size = m_target.getSize();
+  sf::FloatRect bounds(0, 0, static_cast<float>(size.x), static_cast<float>(size.y));
+
+  m_draw_calls = 0;
+  m_damage.clear();
+
+  if (!m_canvas || m_canvas->getSize() != size) {
+    m_canvas.reset(new sf::RenderTexture);
+
+    if (!m_canvas->create(size.x, size.y)) {
+      std::cerr << "Error! Could not create the canvas, drawing everything.\n";
+      m_canvas.reset();
+      m_target.clear(background);
+      draw(area);
+      area.clearDamage();
+      return;
+    }
+
+    m_canvas_renderer.reset(new WidgetRenderer(*m_canvas));
+    m_damage.push_back(bounds);
+  } else {
+    for (auto& rect : area.getDamage()) {
+      // the outline is outside the geometry, and the viewports are in pixels
+      float left = std::floor(rect.left - 1);
+      float top = std::floor(rect.top - 1);
+      float right = std::ceil(rect.left + rect.width + 1);
+      float bottom = std::ceil(rect.top + rect.height + 1);
+
+      sf::FloatRect damage;
+
+      if (bounds.intersects(sf::FloatRect(left, top, right - left, bottom - top), damage)) {
+        m_damage.push_back(damage);
+      }
+    }
+  }
 
-void WidgetRenderer::visitBin(ui::Bin& widget) {
-  if (!widget.hasChild()) {
-    return;
+  area.clearDamage();
+
+  if (!m_damage.empty()) {
+    m_canvas_renderer->renderDamage(area, m_damage, background);
+    m_canvas->display();
+    m_draw_calls += m_canvas_renderer->m_draw_calls;
+    m_culled_count = m_canvas_renderer->m_culled_count;
+  } else {
+    m_culled_count = 0;
   }
 
-  auto geometry = widget.getGeometry();
+  m_target.setView(sf::View(bounds));
+  m_target.draw(sf::Sprite(m_canvas->getTexture()));
+  m_draw_calls++;
+
+  m_target.setView(saved_view);
+}
+
+void WidgetRenderer::renderDamage(ui::Widget& widget, const std::vector<sf::FloatRect>& damage, const sf::Color& background) {
+  auto size = m_target.getSize();
+
+  m_boxes.clear();
+  m_glyphs.clear();
+  m_text_count = 0;
+  m_frame++;
+  m_draw_calls = 0;
 
-  // draw a rectangle around
-  sf::RectangleShape rectangle;
-  rectangle.setSize({ geometry.width, geometry.height });
-  rectangle.setFillColor(sf::Color(0xE0, 0xE0, 0xE0));
-  rectangle.setOutlineColor(sf::Color::Black);
-  rectangle.setOutlineThickness(1);
-  rectangle.setPosition(geometry.left, geometry.top);
-  m_target.draw(rectangle);
+  ui::RenderVisitor visitor(m_commands);
+  m_culled_count = 0;
 
-  widget.getChild()->accept(*this);
+  for (auto& rect : damage) {
+    // the viewport acts as a scissor for the damaged rectangle
+    sf::View view(rect);
+    view.setViewport(sf::FloatRect(rect.left / size.x, rect.top / size.y, rect.width / size.x, rect.height / size.y));
+    m_target.setView(view);
+
+    // erase the previous rendering
+    appendQuad(m_boxes, rect.left, rect.top, rect.width, rect.height, background);
+
+    m_commands.clear();
+    visitor.setClip(&rect);
+    visitor.resetCulledCount();
+    widget.accept(visitor);
+    m_culled_count += visitor.getCulledCount();
+    submit();
+    flush();
+  }
+
+  // the widgets outside the damage have not been visited, so the caches can
+  // only be pruned when everything has been drawn
+  if (damage.size() == 1 && damage.front() == sf::FloatRect(0, 0, static_cast<float>(size.x), static_cast<float>(size.y))) {
+    pruneTextCache();
+    pruneBinCache();
+  }
 }
 
-void WidgetRenderer::visitButton(ui::Button& widget) {
-  auto geometry = widget.getInternalGeometry();
+static sf::FloatRect getVisibleArea(const sf::View& view) {
+  sf::Vector2f center = view.getCenter();
+  sf::Vector2f size = view.getSize();
+  return sf::FloatRect(center.x - size.x / 2, center.y - size.y / 2, size.x, size.y);
+}
 
-  // draw a rectangle around
-  sf::RectangleShape rectangle;
-  rectangle.setSize({ geometry.width, geometry.height });
-  rectangle.setFillColor(sf::Color::White);
-  rectangle.setOutlineColor(widget.isFocused() ? sf::Color::Red : sf::Color::Black);
-  rectangle.setOutlineThickness(1);
-  rectangle.setPosition(geometry.left, geometry.top);
-  m_target.draw(rectangle);
+static sf::View getClipView(const sf::View& base, const sf::FloatRect& clip) {
+  // the viewport of the clip is the part of the viewport of the base view
+  // where the clip is shown, so it acts as a scissor
+  sf::FloatRect visible = getVisibleArea(base);
+  const sf::FloatRect& viewport = base.getViewport();
+
+  sf::View view(clip);
+  view.setViewport(sf::FloatRect(
+    viewport.left + (clip.left - visible.left) / visible.width * viewport.width,
+    viewport.top + (clip.top - visible.top) / visible.height * viewport.height,
+    clip.width / visible.width * viewport.width,
+    clip.height / visible.height * viewport.height
+  ));
+  return view;
+}
 
-  // draw the text
-  sf::Text text;
-  text.setFont(m_font);
-  text.setCharacterSize(CHARACTER_SIZE);
-  text.setColor(sf::Color::Black);
-  text.setString(widget.getText());
+void WidgetRenderer::render(ui::Widget& widget) {
+  // the widgets outside the view are not visited
+  sf::FloatRect visible = getVisibleArea(m_target.getView());
 
-  auto bounds = text.getLocalBounds();
-  float x = geometry.left + (geometry.width - bounds.width) / 2;
-  float y = geometry.top + (geometry.height - bounds.height) / 2;
+  m_commands.clear();
+  ui::RenderVisitor visitor(m_commands);
+  visitor.setClip(&visible);
+  widget.accept(visitor);
+  m_culled_count = visitor.getCulledCount();
+  renderCommands();
+}
 
-  text.setPosition(x, y);
-  m_target.draw(text);
+void WidgetRenderer::renderContent(ui::Bin& widget) {
+  sf::FloatRect visible = getVisibleArea(m_target.getView());
+
+  m_commands.clear();
+  ui::RenderVisitor visitor(m_commands);
+  visitor.setClip(&visible);
+  visitor.visitBinContent(widget);
+  m_culled_count = visitor.getCulledCount();
+  renderCommands();
 }
 
-void WidgetRenderer::visitForm(ui::Form& widget) {
-  visitContainerChildren(widget);
+void WidgetRenderer::renderCommands() {
+  m_boxes.clear();
+  m_glyphs.clear();
+  m_text_count = 0;
+  m_frame++;
+
+  submit();
+  flush();
+
+  pruneTextCache();
+  pruneBinCache();
 }
 
-void WidgetRenderer::visitHBox(ui::HBox& widget) {
-  visitContainerChildren(widget);
+void WidgetRenderer::submit() {
+  const sf::View base = m_target.getView();
+
+  m_clips.clear();
+  m_clips.push_back(getVisibleArea(base));
+
+  // the number of nested clips inside a clip that shows nothing
+  std::size_t hidden = 0;
+
+  for (auto& command : m_commands) {
+    if (hidden > 0) {
+      if (command.type == ui::RenderCommandType::CLIP_BEGIN) {
+        hidden++;
+      } else if (command.type == ui::RenderCommandType::CLIP_END) {
+        hidden--;
+      }
+
+      continue;
+    }
+
+    switch (command.type) {
+      case ui::RenderCommandType::RECTANGLE:
+        addRectangle(command.geometry, command.color);
+        break;
+      case ui::RenderCommandType::OUTLINE:
+        addOutline(command.geometry, command.color);
+        break;
+      case ui::RenderCommandType::TEXT:
+        addText(command);
+        break;
+      case ui::RenderCommandType::CACHE:
+        drawCachedBin(command);
+        break;
+      case ui::RenderCommandType::CLIP_BEGIN: {
+        sf::FloatRect clip;
+
+        if (!m_clips.back().intersects(command.geometry, clip)) {
+          hidden = 1;
+          break;
+        }
+
+        flush();
+        m_clips.push_back(clip);
+        m_target.setView(getClipView(base, clip));
+        break;
+      }
+      case ui::RenderCommandType::CLIP_END:
+        flush();
+        m_clips.pop_back();
+        m_target.setView(m_clips.size() == 1 ? base : getClipView(base, m_clips.back()));
+        break;
+    }
+  }
 }
 
-void WidgetRenderer::visitLabel(ui::Label& widget) {
-  auto geometry = widget.getInternalGeometry();
+void WidgetRenderer::flush() {
+  // all the boxes at once, then all the texts on top
+  if (m_boxes.getVertexCount() > 0) {
+    m_target.draw(m_boxes);
+    m_boxes.clear();
+    m_draw_calls++;
+  }
 
-  // draw a rectangle around
-  sf::RectangleShape rectangle;
-  rectangle.setSize({ geometry.width, geometry.height });
-  rectangle.setFillColor(sf::Color::White);
-  rectangle.setOutlineColor(sf::Color::Black);
-  rectangle.setOutlineThickness(1);
-  rectangle.setPosition(geometry.left, geometry.top);
-  m_target.draw(rectangle);
+  if (m_glyphs.getVertexCount() > 0) {
+    // all the glyphs are in the texture of the font for this size
+    sf::RenderStates states;
+    states.texture = &m_font->getTexture(CHARACTER_SIZE);
+    m_target.draw(m_glyphs, states);
+    m_glyphs.clear();
+    m_draw_calls++;
+  }
+}
 
-  // draw the text
-  sf::Text text;
-  text.setFont(m_font);
-  text.setCharacterSize(CHARACTER_SIZE);
-  text.setColor(sf::Color::Black);
-  text.setString(widget.getText());
+void WidgetRenderer::addRectangle(const sf::FloatRect& geometry, const sf::Color& color) {
+  appendQuad(m_boxes, geometry.left, geometry.top, geometry.width, geometry.height, color);
+}
 
-  auto bounds = text.getLocalBounds();
-  float x = geometry.left + (geometry.width - bounds.width) / 2;
-  float y = geometry.top + (geometry.height - bounds.height) / 2;
+void WidgetRenderer::addOutline(const sf::FloatRect& geometry, const sf::Color& color) {
+  // same as a sf::RectangleShape with an outline thickness of 1
+  static constexpr float thickness = 1.0f;
 
-  text.setPosition(x, y);
-  m_target.draw(text);
+  float left = geometry.left - thickness;
+  float top = geometry.top - thickness;
+  float right = geometry.left + geometry.width;
+  float bottom = geometry.top + geometry.height;
+  float outer_width = geometry.width + 2 * thickness;
+
+  appendQuad(m_boxes, left, top, outer_width, thickness, color);
+  appendQuad(m_boxes, left, bottom, outer_width, thickness, color);
+  appendQuad(m_boxes, left, geometry.top, thickness, geometry.height, color);
+  appendQuad(m_boxes, right, geometry.top, thickness, geometry.height, color);
 }
 
-void WidgetRenderer::visitSelect(ui::Select& widget) {
-  auto geometry = widget.getInternalGeometry();
+void WidgetRenderer::addText(const ui::RenderCommand& command) {
+  if (!m_font) {
+    return;
+  }
 
-  // draw a rectangle around
-  sf::RectangleShape rectangle;
-  rectangle.setSize({ geometry.width, geometry.height });
-  rectangle.setFillColor(sf::Color::White);
-  rectangle.setOutlineColor(widget.isFocused() ? sf::Color::Red : sf::Color::Black);
-  rectangle.setOutlineThickness(1);
-  rectangle.setPosition(geometry.left, geometry.top);
-  m_target.draw(rectangle);
+  CachedText& cached = m_text_cache[command.widget];
 
-  // draw the text
-  sf::Text text;
-  text.setFont(m_font);
-  text.setCharacterSize(CHARACTER_SIZE);
-  text.setColor(sf::Color::Black);
-  text.setString(widget.getSelectedName());
+  const char *str = m_commands.getText(command);
+  std::size_t length = command.text_length;
+
+  // build the glyphs only if something has changed
+  if (cached.font != m_font.get() || cached.size != CHARACTER_SIZE || cached.color != command.color || cached.string.compare(0, std::string::npos, str, length) != 0) {
+    buildText(cached, str, length, command.color);
+  }
 
-  auto bounds = text.getLocalBounds();
-  float x = geometry.left + (geometry.width - bounds.width) / 2;
-  float y = geometry.top + (geometry.height - bounds.height) / 2;
+  const sf::FloatRect& geometry = command.geometry;
+  float x = geometry.left + (geometry.width - cached.bounds.width) / 2;
+  float y = geometry.top + (geometry.height - cached.bounds.height) / 2;
 
-  text.setPosition(x, y);
-  m_target.draw(text);
+  for (auto vertex : cached.vertices) {
+    vertex.position.x += x;
+    vertex.position.y += y;
+    m_glyphs.append(vertex);
+  }
+
+  cached.frame = m_frame;
+  m_text_count++;
 }
 
-void WidgetRenderer::visitStack(ui::Stack& widget) {
-  visitStackTopChild(widget);
+void WidgetRenderer::buildText(CachedText& cached, const char *str, std::size_t length, const sf::Color& color) {
+  // same layout as sf::Text (regular style, single line)
+  cached.string.assign(str, length);
+  cached.font = m_font.get();
+  cached.size = CHARACTER_SIZE;
+  cached.color = color;
+  cached.vertices.clear();
+
+  sf::String string(cached.string);
+
+  float hspace = static_cast<float>(m_font->getGlyph(L' ', CHARACTER_SIZE, false).advance);
+  float x = 0.0f;
+  float y = static_cast<float>(CHARACTER_SIZE);
+
+  float min_x = static_cast<float>(CHARACTER_SIZE);
+  float min_y = static_cast<float>(CHARACTER_SIZE);
+  float max_x = 0.0f;
+  float max_y = 0.0f;
+
+  sf::Uint32 previous = 0;
+
+  for (std::size_t i = 0; i < string.getSize(); ++i) {
+    sf::Uint32 current = string[i];
+
+    x += static_cast<float>(m_font->getKerning(previous, current, CHARACTER_SIZE));
+    previous = current;
+
+    if (current == L' ' || current == L'\t') {
+      min_x = std::min(min_x, x);
+      min_y = std::min(min_y, y);
+      x += (current == L' ') ? hspace : hspace * 4;
+      max_x = std::max(max_x, x);
+      max_y = std::max(max_y, y);
+      continue;
+    }
+
+    const sf::Glyph& glyph = m_font->getGlyph(current, CHARACTER_SIZE, false);
+
+    float left = static_cast<float>(glyph.bounds.left);
+    float top = static_cast<float>(glyph.bounds.top);
+    float right = left + static_cast<float>(glyph.bounds.width);
+    float bottom = top + static_cast<float>(glyph.bounds.height);
+
+    float u1 = static_cast<float>(glyph.textureRect.left);
+    float v1 = static_cast<float>(glyph.textureRect.top);
+    float u2 = u1 + static_cast<float>(glyph.textureRect.width);
+    float v2 = v1 + static_cast<float>(glyph.textureRect.height);
+
+    cached.vertices.push_back(sf::Vertex({ x + left, y + top }, color, { u1, v1 }));
+    cached.vertices.push_back(sf::Vertex({ x + right, y + top }, color, { u2, v1 }));
+    cached.vertices.push_back(sf::Vertex({ x + right, y + bottom }, color, { u2, v2 }));
+    cached.vertices.push_back(sf::Vertex({ x + left, y + bottom }, color, { u1, v2 }));
+
+    min_x = std::min(min_x, x + left);
+    max_x = std::max(max_x, x + right);
+    min_y = std::min(min_y, y + top);
+    max_y = std::max(max_y, y + bottom);
+
+    x += static_cast<float>(glyph.advance);
+  }
+
+  if (cached.vertices.empty() && min_x > max_x) {
+    cached.bounds = sf::FloatRect();
+  } else {
+    cached.bounds = sf::FloatRect(min_x, min_y, max_x - min_x, max_y - min_y);
+  }
 }
 
-void WidgetRenderer::visitTable(ui::Table& widget) {
-  visitContainerChildren(widget);
+void WidgetRenderer::pruneTextCache() {
+  if (m_text_cache.size() == m_text_count) {
+    return;
+  }
+
+  // remove the texts of the widgets that have not been drawn
+  for (auto it = m_text_cache.begin(); it != m_text_cache.end(); ) {
+    if (it->second.frame != m_frame) {
+      it = m_text_cache.erase(it);
+    } else {
+      ++it;
+    }
+  }
 }
 
-void WidgetRenderer::visitToggle(ui::Toggle& widget) {
-  auto geometry = widget.getInternalGeometry();
+void WidgetRenderer::drawCachedBin(const ui::RenderCommand& command) {
+  ui::Bin& widget = *static_cast<ui::Bin *>(command.widget);
+  std::unique_ptr<CachedBin>& cached = m_bin_cache[&widget];
+
+  if (!cached) {
+    cached.reset(new CachedBin);
+  }
+
+  cached->frame = m_frame;
 
-  // draw a rectangle (filled or not)
-  sf::RectangleShape rectangle;
-  rectangle.setSize({ geometry.width, geometry.height });
-  rectangle.setFillColor(widget.isSelected() ? sf::Color(0x80, 0x80, 0x80) : sf::Color::White);
-  rectangle.setOutlineColor(widget.isFocused() ? sf::Color::Red : sf::Color::Black);
-  rectangle.setOutlineThickness(1);
-  rectangle.setPosition(geometry.left, geometry.top);
-  m_target.draw(rectangle);
+  // keep the order of drawing: what is before the bin must be drawn first
+  flush();
+
+  // the outline of the boxes is drawn outside the geometry
+  auto geometry = widget.getGeometry();
+  sf::FloatRect area(geometry.left - 1, geometry.top - 1, geometry.width + 2, geometry.height + 2);
+  unsigned width = static_cast<unsigned>(std::ceil(area.width));
+  unsigned height = static_cast<unsigned>(std::ceil(area.height));
+
+  if (!cached->failed && cached->texture.getSize() != sf::Vector2u(width, height)) {
+    if (!cached->texture.create(width, height)) {
+      std::cerr << "Error! Could not create a texture for a cached widget, drawing it directly.\n";
+      cached->failed = true;
+    }
+
+    cached->renderer.reset();
+  }
+
+  if (cached->failed) {
+    // the bin may be in a scroll area, so its content is moved where the
+    // command is
+    sf::View saved_view = m_target.getView();
+    sf::View view = saved_view;
+    view.move(geometry.left - command.geometry.left, geometry.top - command.geometry.top);
+    m_target.setView(view);
+
+    WidgetRenderer renderer(m_target);
+    renderer.renderContent(widget);
+    m_draw_calls += renderer.m_draw_calls;
+
+    m_target.setView(saved_view);
+    return;
+  }
+
+  // render the bin in the texture only if something has changed
+  if (!cached->renderer || cached->version != widget.getRenderingVersion() || cached->area != area) {
+    if (!cached->renderer) {
+      cached->renderer.reset(new WidgetRenderer(cached->texture));
+    }
+
+    cached->texture.clear(sf::Color::Transparent);
+    cached->texture.setView(sf::View(sf::FloatRect(area.left, area.top, width, height)));
+    cached->renderer->renderContent(widget);
+    cached->texture.display();
+
+    cached->area = area;
+    cached->version = widget.getRenderingVersion();
+  }
+
+  sf::Sprite sprite(cached->texture.getTexture());
+  sprite.setPosition(command.geometry.left - 1, command.geometry.top - 1);
+  m_target.draw(sprite);
+  m_draw_calls++;
 }
 
-void WidgetRenderer::visitVBox(ui::VBox& widget) {
-  visitContainerChildren(widget);
+void WidgetRenderer::pruneBinCache() {
+  // remove the textures of the bins that have not been drawn
+  for (auto it = m_bin_cache.begin(); it != m_bin_cache.end(); ) {
+    if (it->second->frame != m_frame) {
+      it = m_bin_cache.erase(it);
+    } else {
+      ++it;
+    }
+  }
 }
 
-//   std::cerr << "geometry: " << geometry.width << 'x' << geometry.height << " @ " << geometry.left << 'x' << geometry.top << '\n';
+
@@ -16,31 +16,101 @@
 #ifndef WIDGET_RENDERER_H
 #define WIDGET_RENDERER_H
 
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include <SFML/Graphics.hpp>
 
-#include <ui/WidgetVisitor.h>
+#include <ui/Area.h>
+#include <ui/Bin.h>
+#include <ui/RenderCommandList.h>
 
-class WidgetRenderer : public ui::WidgetVisitor {
+class WidgetRenderer {
 public:
   WidgetRenderer(sf::RenderTarget& target);
 
+  // false if the font could not be loaded, the texts are not drawn
+  bool hasFont() const {
+    return m_font != nullptr;
+  }
+
   void draw(ui::Widget& widget, bool debug = false);
 
-  virtual void visitArea(ui::Area& widget) override;
-  virtual void visitBin(ui::Bin& widget) override;
-  virtual void visitButton(ui::Button& widget) override;
-  virtual void visitForm(ui::Form& widget) override;
-  virtual void visitHBox(ui::HBox& widget) override;
-  virtual void visitLabel(ui::Label& widget) override;
-  virtual void visitSelect(ui::Select& widget) override;
-  virtual void visitStack(ui::Stack& widget) override;
-  virtual void visitTable(ui::Table& widget) override;
-  virtual void visitToggle(ui::Toggle& widget) override;
-  virtual void visitVBox(ui::VBox& widget) override;
+  // draw only the damaged part of the area, the rest comes from the previous frame
+  void drawDamage(ui::Area& area, const sf::Color& background = sf::Color::White);
+
+  std::size_t getDrawCallCount() const {
+    return m_draw_calls;
+  }
+
+  // the number of widgets outside the view (or the damage) that were skipped
+  std::size_t getCulledCount() const {
+    return m_culled_count;
+  }
+
+  // the commands of the last rendering, e.g. to dump them
+  const ui::RenderCommandList& getCommands() const {
+    return m_commands;
+  }
+
+private:
+  struct CachedText {
+    std::string string;
+    const sf::Font *font = nullptr;
+    unsigned size = 0;
+    sf::Color color;
+    std::vector<sf::Vertex> vertices; // glyph quads, relative to the text position
+    sf::FloatRect bounds;
+    unsigned long frame = 0;
+  };
+
+  struct CachedBin {
+    sf::RenderTexture texture;
+    std::unique_ptr<WidgetRenderer> renderer; // draws the bin in the texture
+    sf::FloatRect area;
+    unsigned long version = 0;
+    unsigned long frame = 0;
+    bool failed = false;
+  };
+
+  void render(ui::Widget& widget);
+  void renderContent(ui::Bin& widget);
+  void renderDamage(ui::Widget& widget, const std::vector<sf::FloatRect>& damage, const sf::Color& background);
+  void renderCommands();
+  void submit();
+  void flush();
+
+  void addRectangle(const sf::FloatRect& geometry, const sf::Color& color);
+  void addOutline(const sf::FloatRect& geometry, const sf::Color& color);
+  void addText(const ui::RenderCommand& command);
+  void buildText(CachedText& cached, const char *str, std::size_t length, const sf::Color& color);
+  void pruneTextCache();
+  void drawCachedBin(const ui::RenderCommand& command);
+  void pruneBinCache();
 
 private:
   sf::RenderTarget& m_target;
-  sf::Font m_font;
+  std::shared_ptr<sf::Font> m_font;
+
+  ui::RenderCommandList m_commands;
+
+  sf::VertexArray m_boxes;
+  sf::VertexArray m_glyphs;
+  std::size_t m_text_count;
+  std::unordered_map<const ui::Widget *, CachedText> m_text_cache;
+  std::unordered_map<const ui::Bin *, std::unique_ptr<CachedBin>> m_bin_cache;
+
+  std::unique_ptr<sf::RenderTexture> m_canvas; // the result of the previous frames
+  std::unique_ptr<WidgetRenderer> m_canvas_renderer;
+  std::vector<sf::FloatRect> m_damage;
+
+  std::vector<sf::FloatRect> m_clips; // the clips of the scroll areas, in screen coordinates
+
+  unsigned long m_frame;
+  std::size_t m_draw_calls;
+  std::size_t m_culled_count;
 };
 
 
@@ -20,6 +20,7 @@
 
 #include <ui/Action.h>
 #include <ui/Area.h>
+#include <ui/MainLoop.h>
 #include <ui/Label.h>
 #include <ui/DebugVisitor.h>
 
@@ -56,6 +57,9 @@ namespace {
       table->addChild(toggle);
 
       setChild(table);
+
+      // the widgets change rarely, draw them from a texture
+      setCached();
     }
   };
 
@@ -80,29 +84,20 @@ int main() {
   escapeAction->addCloseControl();
   actions.addAction(escapeAction);
 
-  while (window.isOpen()) {
-
-    sf::Event event;
-    while (window.pollEvent(event)) {
-      actions.update(event);
-
-      if (event.type == sf::Event::MouseButtonPressed) {
-        area.onClick(event.mouseButton.button, { static_cast<float>(event.mouseButton.x), static_cast<float>(event.mouseButton.y) });
-      }
-    }
+  ui::MainLoop loop(window, area, actions);
 
+  loop.setUpdateCallback([&]() {
     if (escapeAction->isActive()) {
       window.close();
     }
+  });
 
-    actions.handleArea(area);
-
-    window.clear(sf::Color::White);
-    renderer.draw(area);
-    window.display();
+  loop.setDrawCallback([&]() {
+    // only the widgets that have changed are drawn again
+    renderer.drawDamage(area, sf::Color::White);
+  });
 
-    actions.reset();
-  }
+  loop.run();
 
   return 0;
 }
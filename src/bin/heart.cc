@@ -22,6 +22,7 @@
 #include <ui/Area.h>
 #include <ui/Label.h>
 #include <ui/DebugVisitor.h>
+#include <ui/MainLoop.h>
 
 #include "common/WidgetRenderer.h"
 
@@ -35,25 +36,27 @@ int main() {
 
   area.updateLayout();
 
-  ui::Action escapeAction("Escape");
-  escapeAction.addKeyControl(sf::Keyboard::Escape);
-  escapeAction.addCloseControl();
+  ui::StandardActionSet actions;
 
-  while (window.isOpen()) {
+  auto escapeAction = std::make_shared<ui::Action>("Escape");
+  escapeAction->addKeyControl(sf::Keyboard::Escape);
+  escapeAction->addCloseControl();
+  actions.addAction(escapeAction);
 
-    sf::Event event;
-    while (window.pollEvent(event)) {
-      escapeAction.update(event);
-    }
+  ui::MainLoop loop(window, area, actions);
 
-    if (escapeAction.isActive()) {
+  loop.setUpdateCallback([&]() {
+    if (escapeAction->isActive()) {
       window.close();
     }
+  });
 
+  loop.setDrawCallback([&]() {
     window.clear(sf::Color::White);
     renderer.draw(area);
-    window.display();
-  }
+  });
+
+  loop.run();
 
   return 0;
 }
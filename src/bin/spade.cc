@@ -20,6 +20,8 @@
 
 #include <ui/Action.h>
 
+#include "common/FontCache.h"
+
 static const char *howto =
   "Welcome in the first SUIT example!\n"
   "Push the Esc key to exit."
@@ -30,14 +32,14 @@ int main() {
   window.setKeyRepeatEnabled(false);
   auto size = window.getSize();
 
-  sf::Font font;
-  if (!font.loadFromFile("/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf")) {
-    std::cerr << "Error loading font!" << std::endl;
+  auto font = FontCache::getFont(DEFAULT_FONT);
+
+  if (!font) {
     return 1;
   }
 
   sf::Text text;
-  text.setFont(font);
+  text.setFont(*font);
   text.setCharacterSize(24);
   text.setColor(sf::Color::White);
   text.setString(howto);
@@ -16,10 +16,12 @@
 #ifndef UI_ACTION_H
 #define UI_ACTION_H
 
+#include <map>
 #include <memory>
 #include <vector>
 
 #include <ui/Control.h>
+#include <ui/InputState.h>
 
 
 namespace ui {
@@ -38,6 +40,11 @@ namespace ui {
      */
     Action(std::string name);
 
+    Action(const Action&) = delete;
+    Action& operator=(const Action&) = delete;
+    Action(Action&&) = default;
+    Action& operator=(Action&&) = default;
+
     /**
      * @brief Get the name of the action.
      *
@@ -136,6 +143,36 @@ namespace ui {
      * @sa CloseControl
      */
     void addCloseControl();
+
+    /**
+     * @brief Get the number of controls of the action.
+     *
+     * @return the number of controls of the action.
+     */
+    std::size_t getControlCount() const;
+
+    /**
+     * @brief Return the ith control of the action.
+     *
+     * The controls are stored by value, grouped by type, so the controls
+     * are numbered by type first, and then in the order they were added.
+     * The reference may be invalidated when a control is added.
+     *
+     * @param i the control number (starting from 0).
+     *
+     * @return the ith control of the action.
+     */
+    Control& ithControl(std::size_t i);
+
+    /**
+     * @brief Get the number of controls added to any action since the beginning.
+     *
+     * This counter is used to know if the controls of an action set have
+     * changed.
+     *
+     * @return the number of controls added to any action.
+     */
+    static std::size_t getControlAdditionCount();
     /** @} */
 
     /**
@@ -162,6 +199,26 @@ namespace ui {
      */
     bool isActive();
 
+    /**
+     * @brief Tell whether the action is active in an input state.
+     *
+     * The buttons of the controls of the action are gathered in a mask, so
+     * that the action is evaluated with a few mask operations. A continuous
+     * action is active if one of its buttons is pressed. An instantaneous
+     * action is active if one of its buttons has just been pressed and is
+     * still pressed.
+     *
+     * The controls that are not buttons (e.g. gamepad axes) are not in the
+     * input state, their own state is used instead.
+     *
+     * @param state the input state.
+     *
+     * @return true if the action is active.
+     *
+     * @sa InputState
+     */
+    bool isActive(const InputState& state);
+
     /**
      * @brief Reset the state of the action.
      *
@@ -172,15 +229,52 @@ namespace ui {
     void reset();
     /** @} */
 
+  private:
+    void controlAdded();
+    void updateMask();
+
+    template<typename Function>
+    void forEachControl(Function func) {
+      for (auto& control : m_gamepad_axis_controls) {
+        func(control);
+      }
+
+      for (auto& control : m_gamepad_button_controls) {
+        func(control);
+      }
+
+      for (auto& control : m_key_controls) {
+        func(control);
+      }
+
+      for (auto& control : m_mouse_button_controls) {
+        func(control);
+      }
+
+      for (auto& control : m_close_controls) {
+        func(control);
+      }
+    }
+
   private:
     enum class Type {
       INSTANTANEOUS,
       CONTINUOUS,
     };
 
-    const std::string m_name;
+    std::string m_name;
     Type m_type;
-    std::vector<std::unique_ptr<Control>> m_controls;
+
+    // one contiguous pool for each type of control
+    std::vector<GamepadAxisControl> m_gamepad_axis_controls;
+    std::vector<GamepadButtonControl> m_gamepad_button_controls;
+    std::vector<KeyControl> m_key_controls;
+    std::vector<MouseButtonControl> m_mouse_button_controls;
+    std::vector<CloseControl> m_close_controls;
+
+    InputState::Mask m_mask;
+    bool m_mask_complete;
+    bool m_mask_needed;
   };
 
   /**
@@ -190,6 +284,11 @@ namespace ui {
    */
   class ActionSet {
   public:
+    /**
+     * @brief Construct an empty action set.
+     */
+    ActionSet();
+
     /**
      * @brief Add an action.
      *
@@ -197,9 +296,57 @@ namespace ui {
      */
     void addAction(std::shared_ptr<Action> action);
 
+    /**
+     * @brief A handle on an action owned by the set.
+     */
+    typedef std::size_t Handle;
+
+    /**
+     * @brief Create an action owned by the set.
+     *
+     * The action is stored by value in the set, with the other owned
+     * actions. It is accessed through the returned handle, that stays valid
+     * as long as the set exists.
+     *
+     * @param name the name of the action.
+     *
+     * @return a handle on the new action.
+     */
+    Handle createAction(std::string name);
+
+    /**
+     * @brief Get an action owned by the set.
+     *
+     * The reference may be invalidated by the next call to createAction(),
+     * the handle must be kept instead.
+     *
+     * @param handle the handle on the action.
+     *
+     * @return the action.
+     */
+    Action& getAction(Handle handle) {
+      return m_owned_actions.at(handle);
+    }
+
+    /**
+     * @brief Tell whether an action owned by the set is active.
+     *
+     * @param handle the handle on the action.
+     *
+     * @return true if the action is active.
+     *
+     * @sa Action::isActive()
+     */
+    bool isActive(Handle handle) {
+      return getAction(handle).isActive();
+    }
+
     /**
      * @brief Update all the actions.
      *
+     * The controls of the actions are indexed by their event source, so that
+     * an event is only sent to the controls that can react to it.
+     *
      * @param event the event to update the actions.
      *
      * @sa Action;:update()
@@ -213,8 +360,17 @@ namespace ui {
      */
     void reset();
 
+  private:
+    void updateDispatch();
+
   private:
     std::vector<std::shared_ptr<Action>> m_actions;
+    std::vector<Action> m_owned_actions;
+
+    std::map<EventSource, std::vector<Control *>> m_dispatch;
+    std::vector<Control *> m_any_controls;
+    std::size_t m_control_addition_count;
+    bool m_dispatch_needed;
   };
 
   class Area;
@@ -250,12 +406,12 @@ namespace ui {
     void handleArea(Area& area);
 
   private:
-    std::shared_ptr<Action> m_up;
-    std::shared_ptr<Action> m_down;
-    std::shared_ptr<Action> m_left;
-    std::shared_ptr<Action> m_right;
-    std::shared_ptr<Action> m_primary;
-    std::shared_ptr<Action> m_secondary;
+    Handle m_up;
+    Handle m_down;
+    Handle m_left;
+    Handle m_right;
+    Handle m_primary;
+    Handle m_secondary;
 
   };
 
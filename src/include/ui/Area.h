@@ -16,6 +16,10 @@
 #ifndef UI_AREA_H
 #define UI_AREA_H
 
+#include <vector>
+
+#include <ui/Leaf.h>
+#include <ui/LeafIndex.h>
 #include <ui/Stack.h>
 
 namespace ui {
@@ -44,11 +48,31 @@ namespace ui {
 
     /**
      * @brief Update the layout of the area and its widgets.
+     *
+     * Only the widgets that have been invalidated since the last update (and
+     * the widgets whose geometry has changed as a consequence) are laid out
+     * again. Then, the navigation graph between the focusable widgets is
+     * updated for the widgets that have moved.
+     *
+     * @sa Widget::invalidateLayout()
      */
     void updateLayout();
 
+    /**
+     * @brief Get the number of widgets laid out during the last update.
+     *
+     * @return the number of widgets laid out by the last updateLayout() call.
+     */
+    std::size_t getLayoutCount() const {
+      return m_layout_count;
+    }
+
     /**
      * @brief Change the active widget in the up direction.
+     *
+     * The neighbours of the focusable widgets in the four directions are
+     * computed once after the layout so that changing the active widget
+     * is a simple lookup.
      */
     void onUp();
 
@@ -71,7 +95,159 @@ namespace ui {
 
     virtual void onSecondaryAction() override;
 
+    /**
+     * @brief Dispatch a click directly to the leaf under the mouse.
+     *
+     * If the leaf index is enabled and the layout is up to date, the leaf
+     * is found thanks to the index and its onClick() is called directly,
+     * without going through the containers. A click in a scroll area, a
+     * list view or a grid view is given to this widget, whose content
+     * moves. Otherwise, the click goes through the hierarchy as usual.
+     *
+     * @sa setLeafIndexEnabled()
+     */
+    virtual void onClick(sf::Mouse::Button button, const sf::Vector2f& mouse) override;
+
+    /**
+     * @brief Enable or disable the leaf index.
+     *
+     * The leaf index is a spatial index of the leaves that is built after
+     * each layout update. It makes finding the clicked leaf independent of
+     * the number of widgets. By default, the leaf index is disabled.
+     *
+     * The index bypasses the onClick() functions of the containers and bins,
+     * so it should not be enabled if one of them has a specific behaviour.
+     *
+     * @param enabled true to enable the leaf index.
+     */
+    void setLeafIndexEnabled(bool enabled = true);
+
+    /**
+     * @brief Tell whether the leaf index is enabled.
+     *
+     * @return true if the leaf index is enabled.
+     */
+    bool isLeafIndexEnabled() const {
+      return m_leaf_index_enabled;
+    }
+
+    /**
+     * @brief Find the leaf under a point.
+     *
+     * This function needs the leaf index to be enabled. The leaves inside
+     * a scroll area, a list view or a grid view are not in the index.
+     *
+     * @param point the point to look for.
+     *
+     * @return the leaf under the point or `nullptr` if there is none.
+     */
+    Leaf *findLeaf(const sf::Vector2f& point);
+
+    /**
+     * @brief Get the focused widget.
+     *
+     * @return the focused widget or `nullptr` if no widget is focused.
+     */
+    Leaf *getFocused() {
+      updateFocus();
+      return m_focused;
+    }
+
+    /**
+     * @brief Mark the list of focusable widgets as outdated.
+     *
+     * The list is computed again the next time the focus is needed.
+     */
+    virtual void invalidateFocus() override;
+
+    /**
+     * @name Damage
+     * @{
+     */
+    /**
+     * @brief Add a damaged rectangle to the area.
+     *
+     * Overlapping rectangles are merged. If there are too many rectangles,
+     * they are all merged in their bounding rectangle.
+     *
+     * @param rectangle the damaged rectangle.
+     */
+    virtual void addDamage(const sf::FloatRect& rectangle) override;
+
+    /**
+     * @brief Get the damaged rectangles since the last clearDamage() call.
+     *
+     * A renderer only has to draw the widgets in these rectangles again.
+     *
+     * @return the damaged rectangles (that do not overlap).
+     */
+    const std::vector<sf::FloatRect>& getDamage() const {
+      return m_damage;
+    }
+
+    /**
+     * @brief Tell whether a part of the area has been damaged.
+     *
+     * @return true if the area must be drawn again.
+     */
+    bool isDamaged() const {
+      return !m_damage.empty();
+    }
+
+    /**
+     * @brief Forget the damaged rectangles.
+     *
+     * This function should be called when the area has been drawn.
+     */
+    void clearDamage() {
+      m_damage.clear();
+    }
+    /** @} */
+
     virtual void accept(WidgetVisitor& visitor) override;
+
+    /**
+     * @brief An index that represents no focusable widget.
+     */
+    static constexpr std::size_t NoIndex = static_cast<std::size_t>(-1);
+
+  private:
+    void updateFocus();
+    void updateNavigation();
+    void updateMovedNavigation();
+    void updateLeafIndex();
+    void navigate(std::size_t direction);
+    void changeFocus(std::size_t index);
+    std::size_t findNeighbour(const sf::Vector2f& center, std::size_t direction) const;
+    std::size_t findSortedNeighbour(std::size_t index, std::size_t direction) const;
+
+  private:
+    std::size_t m_layout_count;
+
+    struct Navigation {
+      sf::Vector2f center;
+      std::size_t next[4];
+    };
+
+    std::vector<Leaf*> m_focusable;
+    std::vector<sf::Vector2f> m_translations;
+    std::vector<Navigation> m_navigation;
+    Leaf *m_focused;
+    sf::Vector2f m_focused_translation;
+    std::size_t m_focused_index;
+    bool m_focus_needed;
+    bool m_navigation_needed;
+    std::vector<std::size_t> m_moved;
+    std::vector<bool> m_has_moved;
+    std::vector<std::size_t> m_sorted_x;
+    std::vector<std::size_t> m_sorted_y;
+
+    LeafIndex m_leaf_index;
+    std::vector<Widget*> m_scrolling;
+    bool m_leaf_index_enabled;
+    bool m_leaf_index_needed;
+
+    std::vector<sf::FloatRect> m_damage;
   };
 
 
@@ -27,6 +27,14 @@ namespace ui {
    */
   class Bin : public Widget {
   public:
+    /**
+     * @brief Construct a bin widget without a child.
+     */
+    Bin()
+    : m_child(nullptr)
+    , m_cached(false)
+    {
+    }
 
     /**
      * @brief Set the child of the widget.
@@ -34,7 +42,20 @@ namespace ui {
      * @param child the child of the widget.
      */
     void setChild(Widget *child) {
+      if (m_child != nullptr) {
+        // the new child may have the same geometry as the previous one
+        addDamage(m_child->getGeometry());
+      }
+
       m_child = child;
+
+      if (m_child != nullptr) {
+        m_child->setParent(this);
+      }
+
+      invalidateLayout();
+      invalidateFocus();
+      invalidateRendering();
     }
 
     /**
@@ -55,6 +76,32 @@ namespace ui {
       return m_child;
     }
 
+    /**
+     * @brief Set the cached state of the widget.
+     *
+     * A cached widget can be rendered once in a texture by the renderer,
+     * and the texture is used as long as the rendering version of the widget
+     * does not change. It is useful for static parts of the interface. By
+     * default, a bin is not cached.
+     *
+     * @param cached the new cached state.
+     *
+     * @sa Widget::getRenderingVersion()
+     */
+    void setCached(bool cached = true) {
+      m_cached = cached;
+      invalidateRendering();
+    }
+
+    /**
+     * @brief Tell whether the widget is cached.
+     *
+     * @return true if the widget is cached.
+     */
+    bool isCached() const {
+      return m_cached;
+    }
+
     virtual void onPrimaryAction() override;
 
     virtual void onSecondaryAction() override;
@@ -69,6 +116,7 @@ namespace ui {
 
   private:
     Widget *m_child;
+    bool m_cached;
   };
 
 }
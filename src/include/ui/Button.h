@@ -48,13 +48,23 @@ namespace ui {
       return m_text;
     }
 
+    /**
+     * @brief Change the text of the button.
+     *
+     * @param text the new text of the button.
+     */
+    void setText(std::string text) {
+      m_text = std::move(text);
+      invalidateRendering();
+    }
+
     /**
      * @brief Set the function to call when the button is pressed.
      *
      * @param callback the function to call.
      */
     void setCallback(Callback callback) {
-      m_callback = callback;
+      m_callback = std::move(callback);
     }
 
     virtual void onPrimaryAction() override;
@@ -16,16 +16,179 @@
 #ifndef UI_CALLBACK_H
 #define UI_CALLBACK_H
 
-#include <functional>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace ui {
 
   /**
    * @brief A generic callback function.
    *
+   * A callback can hold any function object (a lambda, generally) that can
+   * be called without arguments. The function object is stored inside the
+   * callback, in a buffer of Callback::BufferSize bytes, so there is never
+   * any memory allocation. A function object that is too large for the
+   * buffer is rejected at compile time.
+   *
+   * A callback can be moved but not copied.
+   *
    * @ingroup widgets
    */
-  typedef std::function<void()> Callback;
+  class Callback {
+  public:
+    /**
+     * @brief The size of the buffer for the function object.
+     */
+    static constexpr std::size_t BufferSize = 64;
+
+    /**
+     * @brief Construct an empty callback.
+     */
+    Callback()
+    : m_invoke(nullptr)
+    , m_manage(nullptr)
+    {
+    }
+
+    /**
+     * @brief Construct an empty callback.
+     */
+    Callback(std::nullptr_t)
+    : Callback()
+    {
+    }
+
+    /**
+     * @brief Construct a callback from a function object.
+     *
+     * @param function the function object.
+     */
+    template<typename Function, typename = typename std::enable_if<!std::is_same<typename std::decay<Function>::type, Callback>::value>::type>
+    Callback(Function&& function)
+    : m_invoke(&invoke<typename std::decay<Function>::type>)
+    , m_manage(&manage<typename std::decay<Function>::type>)
+    {
+      typedef typename std::decay<Function>::type Type;
+      static_assert(sizeof(Type) <= BufferSize, "The function object is too large for a callback");
+      static_assert(alignof(Type) <= alignof(Storage), "The function object is over-aligned for a callback");
+      new (&m_storage) Type(std::forward<Function>(function));
+    }
+
+    Callback(const Callback&) = delete;
+    Callback& operator=(const Callback&) = delete;
+
+    /**
+     * @brief Move constructor.
+     *
+     * @param other the callback to move. It is empty afterwards.
+     */
+    Callback(Callback&& other)
+    : m_invoke(other.m_invoke)
+    , m_manage(other.m_manage)
+    {
+      if (m_manage != nullptr) {
+        m_manage(Operation::MOVE, &m_storage, &other.m_storage);
+      }
+
+      other.m_invoke = nullptr;
+      other.m_manage = nullptr;
+    }
+
+    /**
+     * @brief Move assignment.
+     *
+     * @param other the callback to move. It is empty afterwards.
+     *
+     * @return the callback.
+     */
+    Callback& operator=(Callback&& other) {
+      if (this != &other) {
+        reset();
+
+        m_invoke = other.m_invoke;
+        m_manage = other.m_manage;
+
+        if (m_manage != nullptr) {
+          m_manage(Operation::MOVE, &m_storage, &other.m_storage);
+        }
+
+        other.m_invoke = nullptr;
+        other.m_manage = nullptr;
+      }
+
+      return *this;
+    }
+
+    /**
+     * @brief Destroy the callback.
+     */
+    ~Callback() {
+      reset();
+    }
+
+    /**
+     * @brief Tell whether the callback holds a function object.
+     *
+     * @return true if the callback holds a function object.
+     */
+    explicit operator bool() const {
+      return m_invoke != nullptr;
+    }
+
+    /**
+     * @brief Call the function object.
+     *
+     * The callback must not be empty.
+     */
+    void operator()() {
+      m_invoke(&m_storage);
+    }
+
+  private:
+    enum class Operation {
+      MOVE,
+      DESTROY,
+    };
+
+    typedef typename std::aligned_storage<BufferSize>::type Storage;
+
+    typedef void (*Invoker)(void *);
+    typedef void (*Manager)(Operation, void *, void *);
+
+    template<typename Type>
+    static void invoke(void *storage) {
+      (*static_cast<Type *>(storage))();
+    }
+
+    template<typename Type>
+    static void manage(Operation operation, void *storage, void *other) {
+      switch (operation) {
+        case Operation::MOVE:
+          new (storage) Type(std::move(*static_cast<Type *>(other)));
+          static_cast<Type *>(other)->~Type();
+          break;
+        case Operation::DESTROY:
+          static_cast<Type *>(storage)->~Type();
+          break;
+      }
+    }
+
+    void reset() {
+      if (m_manage != nullptr) {
+        m_manage(Operation::DESTROY, &m_storage, nullptr);
+      }
+
+      m_invoke = nullptr;
+      m_manage = nullptr;
+    }
+
+  private:
+    Storage m_storage;
+    Invoker m_invoke;
+    Manager m_manage;
+  };
 
 }
 
@@ -50,6 +50,10 @@ namespace ui {
      */
     void addChild(Widget *widget) {
       m_children.push_back(widget);
+      widget->setParent(this);
+      invalidateLayout();
+      invalidateFocus();
+      invalidateRendering();
     }
 
     /**
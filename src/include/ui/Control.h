@@ -22,6 +22,49 @@
 
 namespace ui {
 
+  /**
+   * @brief The source of the events that can change the state of a control.
+   *
+   * @ingroup controls
+   */
+  struct EventSource {
+    /**
+     * @brief The type of the source.
+     */
+    enum class Type {
+      ANY,            ///< any event (no specific source)
+      KEY,            ///< a key of the keyboard
+      MOUSE_BUTTON,   ///< a button of the mouse
+      GAMEPAD_BUTTON, ///< a button of a gamepad
+      GAMEPAD_AXIS,   ///< an axis of a gamepad
+      CLOSE,          ///< the close button of the window
+    };
+
+    Type type = Type::ANY;  ///< the type of the source
+    unsigned int id = 0;    ///< the id of the gamepad
+    unsigned int code = 0;  ///< the key, button or axis
+
+    /**
+     * @brief Compute the source of an event.
+     *
+     * @param event the event.
+     *
+     * @return the source of the event, with the type EventSource::Type::ANY
+     * if the event does not come from a specific source.
+     */
+    static EventSource fromEvent(const sf::Event& event);
+  };
+
+  /**
+   * @brief Compare two event sources.
+   *
+   * @param lhs the first source.
+   * @param rhs the second source.
+   *
+   * @return true if the first source is before the second source.
+   */
+  bool operator<(const EventSource& lhs, const EventSource& rhs);
+
   /**
    * @brief A physical control.
    *
@@ -32,16 +75,30 @@ namespace ui {
     /**
      * @brief Construct a control with a name and its controller name.
      *
+     * The names are not copied, they must be valid as long as the control
+     * exists (generally, they are string literals).
+     *
      * @param name the name of the control.
      * @param controller_name the name of the controller
      */
-    Control(std::string name, std::string controller_name)
-    : m_name(std::move(name))
-    , m_controller_name(std::move(controller_name))
+    Control(const char *name, const char *controller_name)
+    : m_name(name)
+    , m_controller_name(controller_name)
     , m_active(false)
     {
     }
 
+    /**
+     * @brief Construct a control with a name and its controller name.
+     *
+     * The names are copied once in a table shared by all the controls, so
+     * that the controls with the same names do not keep their own copies.
+     *
+     * @param name the name of the control.
+     * @param controller_name the name of the controller
+     */
+    Control(const std::string& name, const std::string& controller_name);
+
     /**
      * @brief Destroy the control.
      */
@@ -91,9 +148,21 @@ namespace ui {
      */
     virtual void update(const sf::Event& event) = 0;
 
+    /**
+     * @brief Get the source of the events that can change the control.
+     *
+     * The source is used to send only the relevant events to the control.
+     * By default, the control receives all the events.
+     *
+     * @return the source of the events for the control.
+     *
+     * @sa ActionSet::update()
+     */
+    virtual EventSource getEventSource() const;
+
   private:
-    const std::string m_name;
-    const std::string m_controller_name;
+    const char * const m_name;
+    const char * const m_controller_name;
     bool m_active;
   };
 
@@ -125,6 +194,8 @@ namespace ui {
 
     virtual void update(const sf::Event& event) override;
 
+    virtual EventSource getEventSource() const override;
+
   private:
     const unsigned int m_id;
     const sf::Joystick::Axis m_axis;
@@ -148,6 +219,8 @@ namespace ui {
 
     virtual void update(const sf::Event& event) override;
 
+    virtual EventSource getEventSource() const override;
+
   private:
     const unsigned int m_id;
     const unsigned int m_button;
@@ -169,6 +242,8 @@ namespace ui {
 
     virtual void update(const sf::Event& event) override;
 
+    virtual EventSource getEventSource() const override;
+
   private:
     const sf::Keyboard::Key m_key;
   };
@@ -189,6 +264,8 @@ namespace ui {
 
     virtual void update(const sf::Event& event) override;
 
+    virtual EventSource getEventSource() const override;
+
   private:
     sf::Mouse::Button m_button;
   };
@@ -206,6 +283,8 @@ namespace ui {
     CloseControl();
 
     virtual void update(const sf::Event& event) override;
+
+    virtual EventSource getEventSource() const override;
   };
 
 }
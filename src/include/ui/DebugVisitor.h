@@ -16,7 +16,10 @@
 #ifndef UI_DEBUG_VISITOR_H
 #define UI_DEBUG_VISITOR_H
 
+#include <vector>
+
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
 
 #include <ui/WidgetVisitor.h>
 
@@ -25,6 +28,11 @@ namespace ui {
   /**
    * @brief A visitor to draw a debug view of the widgets.
    *
+   * The outlines of all the widgets are collected in a single vertex array
+   * that is drawn once, when the visit of the root widget is finished.
+   * The outlines of the content of a scroll area, a list view or a grid
+   * view are clipped to the widget, like their rendering.
+   *
    * @ingroup widgets
    */
   class DebugVisitor : public WidgetVisitor {
@@ -36,15 +44,34 @@ namespace ui {
      */
     DebugVisitor(sf::RenderTarget& target)
     : m_target(target)
+    , m_lines(sf::Lines)
+    , m_depth(0)
+    , m_depth_coloring(false)
     {
     }
 
+    /**
+     * @brief Set the depth coloring.
+     *
+     * With depth coloring, the color of the outline of a widget depends on
+     * its depth in the hierarchy rather than on its kind. By default, depth
+     * coloring is disabled.
+     *
+     * @param depth_coloring the new depth coloring state.
+     */
+    void setDepthColoring(bool depth_coloring = true) {
+      m_depth_coloring = depth_coloring;
+    }
+
     virtual void visitArea(Area& widget) override;
     virtual void visitBin(Bin& widget) override;
     virtual void visitButton(Button& widget) override;
     virtual void visitForm(Form& widget) override;
+    virtual void visitGridView(GridView& widget) override;
     virtual void visitHBox(HBox& widget) override;
     virtual void visitLabel(Label& widget) override;
+    virtual void visitListView(ListView& widget) override;
+    virtual void visitScrollArea(ScrollArea& widget) override;
     virtual void visitSelect(Select& widget) override;
     virtual void visitStack(Stack& widget) override;
     virtual void visitTable(Table& widget) override;
@@ -62,8 +89,31 @@ namespace ui {
      */
     void drawWidget(Widget& widget);
 
+    /**
+     * @brief Start the visit of a widget.
+     */
+    void enter();
+
+    /**
+     * @brief Finish the visit of a widget.
+     *
+     * If the widget is the root widget, the outlines are drawn.
+     */
+    void leave();
+
+  private:
+    void beginClip(Widget& widget);
+    void endClip();
+    void addOutline(const sf::FloatRect& geometry, const sf::Color& color);
+    void addLine(sf::Vector2f start, sf::Vector2f end, const sf::Color& color);
+    sf::Color getDepthColor() const;
+
   private:
     sf::RenderTarget& m_target;
+    sf::VertexArray m_lines;
+    std::vector<sf::FloatRect> m_clips;
+    unsigned m_depth;
+    bool m_depth_coloring;
   };
 
 }
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2014, Julien Bernard
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#ifndef UI_EVENT_QUEUE_H
+#define UI_EVENT_QUEUE_H
+
+#include <vector>
+
+#include <SFML/Window.hpp>
+
+namespace ui {
+
+  /**
+   * @brief A queue of events that coalesces the move events of a frame.
+   *
+   * Mice and analog sticks can send many move events during a single frame.
+   * The queue keeps only the latest mouse move event and the latest move
+   * event for each axis of each gamepad. The other events (in particular
+   * button presses and releases) are all kept, in their original order.
+   *
+   * ~~~{.cc}
+   *   while (window.pollEvent(event)) {
+   *     queue.pushEvent(event);
+   *   }
+   *
+   *   while (queue.pollEvent(event)) {
+   *     actions.update(event);
+   *   }
+   * ~~~
+   *
+   * @ingroup controls
+   */
+  class EventQueue {
+  public:
+    /**
+     * @brief Construct an empty queue.
+     */
+    EventQueue();
+
+    /**
+     * @brief Push an event in the queue.
+     *
+     * If the event is a move event, the previous move event of the same
+     * device (and axis) is removed from the queue.
+     *
+     * @param event the event to push.
+     */
+    void pushEvent(const sf::Event& event);
+
+    /**
+     * @brief Pop the next event of the queue.
+     *
+     * @param event the event that is filled if the queue is not empty.
+     *
+     * @return true if an event has been returned.
+     */
+    bool pollEvent(sf::Event& event);
+
+    /**
+     * @brief Get the number of events pushed in the queue.
+     *
+     * @return the number of events pushed since the beginning.
+     */
+    std::size_t getPushedCount() const {
+      return m_pushed_count;
+    }
+
+    /**
+     * @brief Get the number of events removed by coalescing.
+     *
+     * @return the number of events folded since the beginning.
+     */
+    std::size_t getFoldedCount() const {
+      return m_folded_count;
+    }
+
+  private:
+    void clear();
+
+  private:
+    struct Entry {
+      sf::Event event;
+      bool folded;
+    };
+
+    std::vector<Entry> m_entries;
+    std::size_t m_next;
+
+    static constexpr std::size_t SlotCount = 1 + sf::Joystick::Count * sf::Joystick::AxisCount;
+    std::size_t m_slots[SlotCount]; // index of the last move event of each device and axis
+
+    std::size_t m_pushed_count;
+    std::size_t m_folded_count;
+  };
+
+}
+
+#endif // UI_EVENT_QUEUE_H
@@ -0,0 +1,374 @@
+/*
+ * Copyright (c) 2014, Julien Bernard
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#ifndef UI_GRID_VIEW_H
+#define UI_GRID_VIEW_H
+
+#include <vector>
+
+#include <ui/Widget.h>
+
+namespace ui {
+
+  /**
+   * @brief The cells of a grid view.
+   *
+   * The model gives the number of rows and columns and creates the widgets
+   * that show the cells. A cell widget is created once and then bound to
+   * different cells as the grid view scrolls.
+   *
+   * @sa GridView
+   */
+  class GridModel {
+  public:
+    /**
+     * @brief Destroy the model.
+     */
+    virtual ~GridModel();
+
+    /**
+     * @brief Get the number of rows.
+     *
+     * @return the number of rows in the model.
+     */
+    virtual std::size_t getRowCount() const = 0;
+
+    /**
+     * @brief Get the number of columns.
+     *
+     * @return the number of columns in the model.
+     */
+    virtual std::size_t getColumnCount() const = 0;
+
+    /**
+     * @brief Create a new cell widget.
+     *
+     * The widget is owned by the grid view.
+     *
+     * @return a new cell widget.
+     */
+    virtual Widget *createCell() = 0;
+
+    /**
+     * @brief Show a cell in a cell widget.
+     *
+     * The widget may have shown another cell before, so all its state must
+     * be set, including its size hint if it depends on the cell and the
+     * focus state of its focusable leaf.
+     *
+     * @param widget a widget created by createCell().
+     * @param row the row of the cell to show.
+     * @param column the column of the cell to show.
+     * @param focused true if the cell contains the focused leaf.
+     */
+    virtual void updateCell(Widget& widget, std::size_t row, std::size_t column, bool focused) = 0;
+  };
+
+  /**
+   * @brief A scrollable grid of cells that only creates the visible cells.
+   *
+   * All the rows have the same height. The width of a column is the
+   * largest width hint of its cells in a sample of the rows, so that the
+   * columns can be measured without looking at all the rows. The grid view
+   * keeps a widget for each visible cell, and the widgets of the cells
+   * that are scrolled out are recycled for the cells that are scrolled in.
+   * So scrolling, the rendering and the clicks only depend on the number
+   * of visible cells.
+   *
+   * The columns are measured again only when the cells are invalidated,
+   * not when the grid view scrolls or is resized.
+   *
+   * As in a list view, the widget of the focused cell is not recycled when
+   * it is scrolled out, and the grid view scrolls when the focus reaches a
+   * cell on its border.
+   *
+   * The size hint of a grid view does not depend on its cells. By default,
+   * its size policy is SizePolicy::MINIMUM so that it takes all the space
+   * given by its parent.
+   *
+   * @ingroup widgets
+   */
+  class GridView : public Widget {
+  public:
+    /**
+     * @brief The default number of sampled rows.
+     */
+    static constexpr std::size_t DefaultSampleCount = 64;
+
+    /**
+     * @brief The index of no row.
+     */
+    static constexpr std::size_t NoRow = static_cast<std::size_t>(-1);
+
+    /**
+     * @brief Construct a grid view.
+     *
+     * The model is not owned by the grid view, it must live as long as the
+     * grid view.
+     *
+     * @param model the model of the cells.
+     * @param row_height the height of a row.
+     */
+    GridView(GridModel& model, float row_height);
+
+    /**
+     * @brief Destroy the grid view and its cell widgets.
+     */
+    virtual ~GridView();
+
+    /**
+     * @brief Set the height of a row.
+     *
+     * @param row_height the new height of a row.
+     */
+    void setRowHeight(float row_height);
+
+    /**
+     * @brief Get the height of a row.
+     *
+     * @return the height of a row.
+     */
+    float getRowHeight() const {
+      return m_row_height;
+    }
+
+    /**
+     * @brief Set the number of rows used to measure the columns.
+     *
+     * The sampled rows are spread over all the rows, the first and the
+     * last rows are always sampled.
+     *
+     * @param count the number of sampled rows (at least 1).
+     */
+    void setSampleCount(std::size_t count);
+
+    /**
+     * @brief Get the width of a column.
+     *
+     * @param column the index of the column.
+     * @return the width of the column.
+     */
+    float getColumnWidth(std::size_t column) const {
+      return m_column_starts[column + 1] - m_column_starts[column];
+    }
+
+    /**
+     * @brief Get the size of all the cells.
+     *
+     * @return the size of the grid.
+     */
+    sf::Vector2f getContentSize() const;
+
+    /**
+     * @brief Tell that the cells of the model have changed.
+     *
+     * The columns are measured again and all the visible cells are shown
+     * again with GridModel::updateCell().
+     */
+    void invalidateCells();
+
+    /**
+     * @name Scrolling
+     * @{
+     */
+    /**
+     * @brief Set the offset of the cells.
+     *
+     * The offset is clamped so that the grid view does not show anything
+     * past the last row and the last column.
+     *
+     * @param offset the new offset.
+     */
+    void setOffset(const sf::Vector2f& offset);
+
+    /**
+     * @brief Get the offset of the cells.
+     *
+     * @return the current offset.
+     */
+    const sf::Vector2f& getOffset() const {
+      return m_offset;
+    }
+
+    /**
+     * @brief Move the cells.
+     *
+     * @param delta the change of the offset.
+     */
+    void scroll(const sf::Vector2f& delta) {
+      setOffset(m_offset + delta);
+    }
+
+    /**
+     * @brief Change the offset so that a cell is shown.
+     *
+     * @param row the row of the cell.
+     * @param column the column of the cell.
+     */
+    void scrollToCell(std::size_t row, std::size_t column);
+    /** @} */
+
+    /**
+     * @name Visible cells
+     * @{
+     */
+    /**
+     * @brief Get the index of the first visible row.
+     *
+     * @return the index of the first visible row.
+     */
+    std::size_t getFirstVisibleRow() const {
+      return m_first_row;
+    }
+
+    /**
+     * @brief Get the index of the first visible column.
+     *
+     * @return the index of the first visible column.
+     */
+    std::size_t getFirstVisibleColumn() const {
+      return m_first_column;
+    }
+
+    /**
+     * @brief Get the number of visible cells.
+     *
+     * @return the number of visible cells, including the partially visible
+     * cells.
+     */
+    std::size_t getVisibleCellCount() const {
+      return m_cells.size();
+    }
+
+    /**
+     * @brief Get the number of cell widgets.
+     *
+     * @return the number of cell widgets created by the model, visible or
+     * not.
+     */
+    std::size_t getCellWidgetCount() const {
+      return m_cells.size() + m_spare_cells.size() + (getHiddenFocusedCell() != nullptr ? 1 : 0);
+    }
+
+    /**
+     * @brief Get the row of the focused cell.
+     *
+     * @return the row of the cell that contains the focused leaf, or NoRow
+     * if the focus is not in the grid view.
+     */
+    std::size_t getFocusedRow() const {
+      return m_focused_row;
+    }
+
+    /**
+     * @brief Get the column of the focused cell.
+     *
+     * @return the column of the cell that contains the focused leaf. It is
+     * meaningless if the focus is not in the grid view.
+     */
+    std::size_t getFocusedColumn() const {
+      return m_focused_column;
+    }
+
+    /**
+     * @brief Get the widget of the focused cell if it is not visible.
+     *
+     * @return the widget of the focused cell if the cell is scrolled out,
+     * or `nullptr` otherwise.
+     */
+    Widget *getHiddenFocusedCell() const;
+
+    typedef typename std::vector<Widget *>::iterator iterator;
+
+    /**
+     * @brief Get the widget of the first visible cell.
+     *
+     * The visible cells are ordered row by row.
+     *
+     * @return an iterator on the visible cell widgets.
+     */
+    iterator begin() {
+      return m_cells.begin();
+    }
+
+    /**
+     * @brief Get the end of the visible cells.
+     *
+     * @return an iterator past the last visible cell widget.
+     */
+    iterator end() {
+      return m_cells.end();
+    }
+    /** @} */
+
+    virtual void onClick(sf::Mouse::Button button, const sf::Vector2f& mouse) override;
+
+    virtual void layoutRequest() override;
+
+    virtual void layoutAllocation() override;
+
+    /**
+     * @brief Add a damaged rectangle of a cell.
+     *
+     * The rectangle is clipped to the grid view before being forwarded to
+     * the parent.
+     *
+     * @param rectangle the damaged rectangle.
+     */
+    virtual void addDamage(const sf::FloatRect& rectangle) override;
+
+    virtual void childFocusChanged(Widget& child, Leaf& leaf, bool focused) override;
+
+    virtual void accept(WidgetVisitor& visitor) override;
+
+  private:
+    sf::Vector2f clampOffset(const sf::Vector2f& offset) const;
+    sf::Vector2f revealOffset(std::size_t row, std::size_t column) const;
+    bool isVisibleCell(std::size_t row, std::size_t column) const;
+    std::size_t findColumn(float position) const;
+    void measureColumns();
+    void updateCells();
+    void bindCell(Widget& widget, std::size_t row, std::size_t column);
+    Widget *takeSpareCell();
+    void placeCells();
+    void placeCell(Widget& widget, std::size_t row, std::size_t column);
+
+  private:
+    GridModel& m_model;
+    float m_row_height;
+    std::size_t m_sample_count;
+    std::vector<float> m_column_starts;
+    sf::Vector2f m_offset;
+
+    std::size_t m_first_row;
+    std::size_t m_first_column;
+    std::size_t m_row_count; // visible
+    std::size_t m_column_count; // visible
+    std::vector<Widget *> m_cells;
+    std::vector<Widget *> m_next_cells;
+    std::vector<Widget *> m_spare_cells;
+
+    std::size_t m_focused_row;
+    std::size_t m_focused_column;
+    Widget *m_focused_widget; // visible or not
+
+    bool m_measure_needed;
+    bool m_bind_needed;
+    bool m_reveal_needed;
+  };
+
+}
+
+#endif // UI_GRID_VIEW_H
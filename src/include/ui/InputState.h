@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2014, Julien Bernard
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#ifndef UI_INPUT_STATE_H
+#define UI_INPUT_STATE_H
+
+#include <bitset>
+
+#include <SFML/Window.hpp>
+
+#include <ui/Control.h>
+
+namespace ui {
+
+  /**
+   * @brief A snapshot of the state of the keyboard, mouse and gamepad buttons.
+   *
+   * The state of each button is stored in a bitset, so that the state of any
+   * button can be queried in constant time. Besides the pressed buttons, the
+   * state records the buttons that have just been pressed or released during
+   * the current frame.
+   *
+   * ~~~{.cc}
+   *   while (window.pollEvent(event)) {
+   *     state.update(event);
+   *   }
+   *
+   *   if (state.isKeyJustPressed(sf::Keyboard::Space)) {
+   *     // ...
+   *   }
+   *
+   *   state.nextFrame();
+   * ~~~
+   *
+   * @ingroup controls
+   */
+  class InputState {
+  public:
+    static constexpr std::size_t KeyCount = sf::Keyboard::KeyCount; ///< Number of keys
+    static constexpr std::size_t MouseButtonCount = sf::Mouse::ButtonCount; ///< Number of mouse buttons
+    static constexpr std::size_t GamepadCount = sf::Joystick::Count; ///< Number of gamepads
+    static constexpr std::size_t GamepadButtonCount = sf::Joystick::ButtonCount; ///< Number of buttons per gamepad
+
+    static constexpr std::size_t Size = KeyCount + MouseButtonCount + GamepadCount * GamepadButtonCount + 1; ///< Number of bits in a mask
+
+    /**
+     * @brief A set of buttons.
+     */
+    typedef std::bitset<Size> Mask;
+
+    /**
+     * @brief An index that represents no button.
+     */
+    static constexpr std::size_t NoIndex = static_cast<std::size_t>(-1);
+
+    /**
+     * @brief Compute the index of a button in a mask.
+     *
+     * Only keys, mouse buttons, gamepad buttons and the close button have an
+     * index. Gamepad axes are not buttons so they have no index.
+     *
+     * @param source the source of the events for the button.
+     *
+     * @return the index of the button or NoIndex if the source is not a button.
+     */
+    static std::size_t getIndex(const EventSource& source);
+
+    /**
+     * @brief Update the state thanks to an event.
+     *
+     * When the window loses the focus, all the pressed buttons are
+     * released, as the window does not get their release events.
+     *
+     * @param event the event to update the state.
+     */
+    void update(const sf::Event& event);
+
+    /**
+     * @brief Start a new frame.
+     *
+     * The buttons that have just been pressed or released are forgotten. The
+     * pressed buttons stay pressed.
+     */
+    void nextFrame();
+
+    /**
+     * @name Masks
+     * @{
+     */
+    /**
+     * @brief Get the pressed buttons.
+     *
+     * @return a mask of the pressed buttons.
+     */
+    const Mask& getPressed() const {
+      return m_pressed;
+    }
+
+    /**
+     * @brief Get the buttons that have been pressed during the frame.
+     *
+     * @return a mask of the buttons that have just been pressed.
+     */
+    const Mask& getJustPressed() const {
+      return m_just_pressed;
+    }
+
+    /**
+     * @brief Get the buttons that have been released during the frame.
+     *
+     * @return a mask of the buttons that have just been released.
+     */
+    const Mask& getJustReleased() const {
+      return m_just_released;
+    }
+    /** @} */
+
+    /**
+     * @name Queries
+     * @{
+     */
+    /**
+     * @brief Tell whether a key is pressed.
+     *
+     * @param key the key of the keyboard.
+     *
+     * @return true if the key is pressed.
+     */
+    bool isKeyPressed(sf::Keyboard::Key key) const;
+
+    /**
+     * @brief Tell whether a key has been pressed during the frame.
+     *
+     * @param key the key of the keyboard.
+     *
+     * @return true if the key has just been pressed.
+     */
+    bool isKeyJustPressed(sf::Keyboard::Key key) const;
+
+    /**
+     * @brief Tell whether a key has been released during the frame.
+     *
+     * @param key the key of the keyboard.
+     *
+     * @return true if the key has just been released.
+     */
+    bool isKeyJustReleased(sf::Keyboard::Key key) const;
+
+    /**
+     * @brief Tell whether a mouse button is pressed.
+     *
+     * @param button the button of the mouse.
+     *
+     * @return true if the button is pressed.
+     */
+    bool isMouseButtonPressed(sf::Mouse::Button button) const;
+
+    /**
+     * @brief Tell whether a mouse button has been pressed during the frame.
+     *
+     * @param button the button of the mouse.
+     *
+     * @return true if the button has just been pressed.
+     */
+    bool isMouseButtonJustPressed(sf::Mouse::Button button) const;
+
+    /**
+     * @brief Tell whether a mouse button has been released during the frame.
+     *
+     * @param button the button of the mouse.
+     *
+     * @return true if the button has just been released.
+     */
+    bool isMouseButtonJustReleased(sf::Mouse::Button button) const;
+
+    /**
+     * @brief Tell whether a gamepad button is pressed.
+     *
+     * @param id the id of the gamepad.
+     * @param button the button of the gamepad.
+     *
+     * @return true if the button is pressed.
+     */
+    bool isGamepadButtonPressed(unsigned int id, unsigned int button) const;
+
+    /**
+     * @brief Tell whether a gamepad button has been pressed during the frame.
+     *
+     * @param id the id of the gamepad.
+     * @param button the button of the gamepad.
+     *
+     * @return true if the button has just been pressed.
+     */
+    bool isGamepadButtonJustPressed(unsigned int id, unsigned int button) const;
+
+    /**
+     * @brief Tell whether a gamepad button has been released during the frame.
+     *
+     * @param id the id of the gamepad.
+     * @param button the button of the gamepad.
+     *
+     * @return true if the button has just been released.
+     */
+    bool isGamepadButtonJustReleased(unsigned int id, unsigned int button) const;
+
+    /**
+     * @brief Tell whether the window has been closed.
+     *
+     * @return true if the window has been closed.
+     */
+    bool isClosed() const;
+    /** @} */
+
+  private:
+    static bool test(const Mask& mask, const EventSource& source);
+
+  private:
+    Mask m_pressed;
+    Mask m_just_pressed;
+    Mask m_just_released;
+  };
+
+}
+
+#endif // UI_INPUT_STATE_H
@@ -47,6 +47,16 @@ namespace ui {
       return m_text;
     }
 
+    /**
+     * @brief Change the text of the label.
+     *
+     * @param text the new text of the label.
+     */
+    void setText(std::string text) {
+      m_text = std::move(text);
+      invalidateRendering();
+    }
+
     virtual void accept(WidgetVisitor& visitor) override;
 
   private:
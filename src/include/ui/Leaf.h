@@ -64,6 +64,7 @@ namespace ui {
      */
     void setFocusable(bool focusable = true) {
       m_focusable = focusable;
+      invalidateFocus();
     }
 
     /**
@@ -84,6 +85,15 @@ namespace ui {
      */
     void setFocused(bool focused = true) {
       m_focused = focused;
+
+      Widget *parent = getParent();
+
+      if (parent != nullptr) {
+        parent->childFocusChanged(*this, *this, focused);
+      }
+
+      invalidateFocus();
+      invalidateRendering();
     }
 
     /** @} */
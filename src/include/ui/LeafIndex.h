@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2014, Julien Bernard
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#ifndef UI_LEAF_INDEX_H
+#define UI_LEAF_INDEX_H
+
+#include <vector>
+
+#include <ui/Leaf.h>
+
+namespace ui {
+
+  /**
+   * @brief A spatial index of leaf widgets.
+   *
+   * The index is a uniform grid over the geometry of the leaves. It answers
+   * the question "which leaf is under this point" by checking only the
+   * leaves that overlap the cell of the point.
+   *
+   * The geometry of the leaves is copied when the index is built so the
+   * index must be built again after a layout update.
+   *
+   * @ingroup widgets
+   */
+  class LeafIndex {
+  public:
+    /**
+     * @brief Remove all the leaves from the index.
+     */
+    void clear();
+
+    /**
+     * @brief Add a leaf to the index.
+     *
+     * If several leaves are under the same point, the first added leaf is
+     * found.
+     *
+     * @param leaf the leaf to add.
+     */
+    void addLeaf(Leaf *leaf);
+
+    /**
+     * @brief Build the grid of the index.
+     *
+     * This function must be called after all the leaves have been added.
+     *
+     * @param bounds the bounds of the grid.
+     */
+    void build(const sf::FloatRect& bounds);
+
+    /**
+     * @brief Find the leaf under a point.
+     *
+     * @param point the point to look for.
+     *
+     * @return the leaf under the point or `nullptr` if there is none.
+     */
+    Leaf *find(const sf::Vector2f& point) const;
+
+  private:
+    std::size_t cellColumn(float x) const;
+    std::size_t cellRow(float y) const;
+
+  private:
+    std::vector<Leaf *> m_leaves;
+    std::vector<sf::FloatRect> m_geometry;
+
+    sf::FloatRect m_bounds;
+    std::size_t m_cols = 0;
+    std::size_t m_rows = 0;
+    float m_cell_width = 0.0f;
+    float m_cell_height = 0.0f;
+
+    std::vector<std::size_t> m_cells; // offsets in m_items for each cell
+    std::vector<std::size_t> m_items; // indices in m_leaves
+    std::vector<std::size_t> m_next; // next free item of each cell, while building
+  };
+
+}
+
+#endif // UI_LEAF_INDEX_H
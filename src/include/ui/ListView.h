@@ -0,0 +1,311 @@
+/*
+ * Copyright (c) 2014, Julien Bernard
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#ifndef UI_LIST_VIEW_H
+#define UI_LIST_VIEW_H
+
+#include <vector>
+
+#include <ui/Widget.h>
+
+namespace ui {
+
+  /**
+   * @brief The rows of a list view.
+   *
+   * The model gives the number of rows and creates the widgets that show
+   * the rows. A row widget is created once and then bound to different
+   * rows as the list view scrolls.
+   *
+   * @sa ListView
+   */
+  class ListModel {
+  public:
+    /**
+     * @brief Destroy the model.
+     */
+    virtual ~ListModel();
+
+    /**
+     * @brief Get the number of rows.
+     *
+     * @return the number of rows in the model.
+     */
+    virtual std::size_t getRowCount() const = 0;
+
+    /**
+     * @brief Create a new row widget.
+     *
+     * The widget is owned by the list view.
+     *
+     * @return a new row widget.
+     */
+    virtual Widget *createRow() = 0;
+
+    /**
+     * @brief Show a row in a row widget.
+     *
+     * The widget may have shown another row before, so all its state must
+     * be set, including the focus state of its focusable leaf.
+     *
+     * @param widget a widget created by createRow().
+     * @param index the index of the row to show.
+     * @param focused true if the row contains the focused leaf.
+     */
+    virtual void updateRow(Widget& widget, std::size_t index, bool focused) = 0;
+  };
+
+  /**
+   * @brief A scrollable list of rows that only creates the visible rows.
+   *
+   * All the rows have the same height, so that the visible rows are known
+   * without looking at the other rows. The list view keeps a widget for
+   * each visible row, and the widgets of the rows that are scrolled out
+   * are recycled for the rows that are scrolled in. So the layout, the
+   * rendering and the clicks only depend on the number of visible rows,
+   * not on the number of rows of the model.
+   *
+   * The list view knows which row contains the focused leaf. The widget of
+   * this row is not recycled when it is scrolled out, so that the focus is
+   * not lost, and the list view scrolls when the focus reaches the first
+   * or the last visible row, so that the focus can move to the next rows.
+   *
+   * The size hint of a list view does not depend on its rows. By default,
+   * its size policy is SizePolicy::MINIMUM so that it takes all the space
+   * given by its parent.
+   *
+   * @ingroup widgets
+   */
+  class ListView : public Widget {
+  public:
+    /**
+     * @brief The index of no row.
+     */
+    static constexpr std::size_t NoRow = static_cast<std::size_t>(-1);
+
+    /**
+     * @brief Construct a list view.
+     *
+     * The model is not owned by the list view, it must live as long as the
+     * list view.
+     *
+     * @param model the model of the rows.
+     * @param row_height the height of a row.
+     */
+    ListView(ListModel& model, float row_height);
+
+    /**
+     * @brief Destroy the list view and its row widgets.
+     */
+    virtual ~ListView();
+
+    /**
+     * @brief Set the height of a row.
+     *
+     * @param row_height the new height of a row.
+     */
+    void setRowHeight(float row_height);
+
+    /**
+     * @brief Get the height of a row.
+     *
+     * @return the height of a row.
+     */
+    float getRowHeight() const {
+      return m_row_height;
+    }
+
+    /**
+     * @brief Tell that the rows of the model have changed.
+     *
+     * The visible rows from the first changed row are shown again with
+     * ListModel::updateRow() at the next layout update. The rows before
+     * are kept as they are.
+     *
+     * @param first the index of the first changed row.
+     */
+    void invalidateRows(std::size_t first = 0);
+
+    /**
+     * @name Scrolling
+     * @{
+     */
+    /**
+     * @brief Set the vertical offset of the rows.
+     *
+     * The offset is clamped so that the list view does not show anything
+     * past the last row.
+     *
+     * @param offset the new offset.
+     */
+    void setOffset(float offset);
+
+    /**
+     * @brief Get the vertical offset of the rows.
+     *
+     * @return the current offset.
+     */
+    float getOffset() const {
+      return m_offset;
+    }
+
+    /**
+     * @brief Move the rows.
+     *
+     * @param delta the change of the offset.
+     */
+    void scroll(float delta) {
+      setOffset(m_offset + delta);
+    }
+
+    /**
+     * @brief Change the offset so that a row is shown.
+     *
+     * @param index the index of the row.
+     */
+    void scrollToRow(std::size_t index);
+    /** @} */
+
+    /**
+     * @name Visible rows
+     * @{
+     */
+    /**
+     * @brief Get the index of the first visible row.
+     *
+     * @return the index of the first visible row.
+     */
+    std::size_t getFirstVisibleRow() const {
+      return m_first;
+    }
+
+    /**
+     * @brief Get the number of visible rows.
+     *
+     * @return the number of visible rows, including the partially visible
+     * rows.
+     */
+    std::size_t getVisibleRowCount() const {
+      return m_rows.size();
+    }
+
+    /**
+     * @brief Get the number of row widgets.
+     *
+     * @return the number of row widgets created by the model, visible or
+     * not.
+     */
+    std::size_t getRowWidgetCount() const {
+      return m_rows.size() + m_spare_rows.size() + (getHiddenFocusedRow() != nullptr ? 1 : 0);
+    }
+
+    /**
+     * @brief Get the index of the focused row.
+     *
+     * @return the index of the row that contains the focused leaf, or
+     * NoRow if the focus is not in the list view.
+     */
+    std::size_t getFocusedRow() const {
+      return m_focused_row;
+    }
+
+    /**
+     * @brief Get the widget of the focused row if it is not visible.
+     *
+     * @return the widget of the focused row if the row is scrolled out, or
+     * `nullptr` otherwise.
+     */
+    Widget *getHiddenFocusedRow() const;
+
+    typedef typename std::vector<Widget *>::iterator iterator;
+
+    /**
+     * @brief Get the widget of the first visible row.
+     *
+     * @return an iterator on the visible row widgets.
+     */
+    iterator begin() {
+      return m_rows.begin();
+    }
+
+    /**
+     * @brief Get the end of the visible rows.
+     *
+     * @return an iterator past the last visible row widget.
+     */
+    iterator end() {
+      return m_rows.end();
+    }
+    /** @} */
+
+    virtual void onClick(sf::Mouse::Button button, const sf::Vector2f& mouse) override;
+
+    virtual void layoutRequest() override;
+
+    virtual void layoutAllocation() override;
+
+    /**
+     * @brief Add a damaged rectangle of a row.
+     *
+     * The rectangle is clipped to the list view before being forwarded to
+     * the parent.
+     *
+     * @param rectangle the damaged rectangle.
+     */
+    virtual void addDamage(const sf::FloatRect& rectangle) override;
+
+    virtual void childFocusChanged(Widget& child, Leaf& leaf, bool focused) override;
+
+    virtual void accept(WidgetVisitor& visitor) override;
+
+  protected:
+    /**
+     * @brief Move the focus to another row.
+     *
+     * This function is called when the rows of the model are moved. The
+     * rows must be invalidated so that the focus is shown at its new place.
+     *
+     * @param index the new index of the focused row, or NoRow.
+     */
+    void setFocusedRow(std::size_t index) {
+      m_focused_row = index;
+    }
+
+  private:
+    float clampOffset(float offset) const;
+    float revealOffset(std::size_t index) const;
+    void updateRows();
+    void bindRow(Widget& widget, std::size_t index);
+    void placeRows();
+    void placeRow(Widget& widget, std::size_t index);
+
+  private:
+    ListModel& m_model;
+    float m_row_height;
+    float m_offset;
+    std::size_t m_first;
+    std::vector<Widget *> m_rows;
+    std::vector<Widget *> m_next_rows;
+    std::vector<Widget *> m_spare_rows;
+    std::size_t m_bind_first; // the rows from this index must be bound again
+
+    std::size_t m_focused_row;
+    Widget *m_focused_widget; // visible or not
+    bool m_reveal_needed;
+  };
+
+}
+
+#endif // UI_LIST_VIEW_H
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2014, Julien Bernard
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#ifndef UI_MAIN_LOOP_H
+#define UI_MAIN_LOOP_H
+
+#include <vector>
+
+#include <SFML/System.hpp>
+#include <SFML/Window.hpp>
+
+#include <ui/Action.h>
+#include <ui/Area.h>
+#include <ui/Callback.h>
+#include <ui/EventQueue.h>
+
+namespace ui {
+
+  /**
+   * @brief A main loop that sleeps when the interface is idle.
+   *
+   * The loop handles the events of the window with an action set and an
+   * area. Then, the area is laid out and drawn again only if something
+   * has changed: an event, a timer, a damaged widget or an explicit call to
+   * invalidate(). When there is nothing to do, the loop blocks until the
+   * next event or the next timer, so that a static interface does not use
+   * any CPU.
+   *
+   * ~~~{.cc}
+   *   ui::MainLoop loop(window, area, actions);
+   *
+   *   loop.setUpdateCallback([&]() {
+   *     if (actions.isActive(escape)) {
+   *       window.close();
+   *     }
+   *   });
+   *
+   *   loop.setDrawCallback([&]() {
+   *     renderer.drawDamage(area);
+   *   });
+   *
+   *   loop.run();
+   * ~~~
+   *
+   * @ingroup controls
+   */
+  class MainLoop {
+  public:
+    /**
+     * @brief Construct a main loop.
+     *
+     * @param window the window of the interface.
+     * @param area the area that receives the clicks and the actions.
+     * @param actions the actions of the interface.
+     */
+    MainLoop(sf::Window& window, Area& area, StandardActionSet& actions);
+
+    /**
+     * @brief Set the update callback.
+     *
+     * The update callback is called once per iteration, after the events
+     * have been handled and before the area is laid out. It is the place
+     * to check the actions of the application.
+     *
+     * @param callback the update callback.
+     */
+    void setUpdateCallback(Callback callback) {
+      m_update_callback = std::move(callback);
+    }
+
+    /**
+     * @brief Set the draw callback.
+     *
+     * The draw callback is called only when the area must be drawn again.
+     * The window is displayed after the callback.
+     *
+     * @param callback the draw callback.
+     */
+    void setDrawCallback(Callback callback) {
+      m_draw_callback = std::move(callback);
+    }
+
+    /**
+     * @brief Add a timer.
+     *
+     * The callback is called once, during the first iteration after the
+     * delay. The loop does not sleep past the deadline of a timer.
+     *
+     * @param delay the delay from now.
+     * @param callback the callback of the timer.
+     */
+    void addTimer(sf::Time delay, Callback callback);
+
+    /**
+     * @brief Ask for the area to be drawn again.
+     *
+     * It can be called from the update callback at each iteration for an
+     * animation.
+     */
+    void invalidate() {
+      m_draw_needed = true;
+    }
+
+    /**
+     * @brief Run the loop until the window is closed.
+     */
+    void run();
+
+    /**
+     * @brief Get the number of iterations of the loop.
+     *
+     * @return the number of iterations since the beginning.
+     */
+    std::size_t getIterationCount() const {
+      return m_iteration_count;
+    }
+
+    /**
+     * @brief Get the number of times the area has been drawn.
+     *
+     * @return the number of draws since the beginning.
+     */
+    std::size_t getDrawCount() const {
+      return m_draw_count;
+    }
+
+    /**
+     * @brief Get the time spent waiting for an event.
+     *
+     * @return the idle time since the beginning.
+     */
+    sf::Time getIdleTime() const {
+      return m_idle_time;
+    }
+
+  private:
+    bool isIdle() const;
+    bool waitEvent(sf::Event& event);
+    void handleEvent(const sf::Event& event);
+    void runTimers();
+
+  private:
+    sf::Window& m_window;
+    Area& m_area;
+    StandardActionSet& m_actions;
+
+    Callback m_update_callback;
+    Callback m_draw_callback;
+
+    struct Timer {
+      sf::Time deadline;
+      Callback callback;
+    };
+
+    std::vector<Timer> m_timers;
+    std::vector<Timer> m_expired; // kept to avoid an allocation at each iteration
+    sf::Clock m_clock;
+
+    EventQueue m_queue;
+    bool m_draw_needed;
+
+    std::size_t m_iteration_count;
+    std::size_t m_draw_count;
+    sf::Time m_idle_time;
+  };
+
+}
+
+#endif // UI_MAIN_LOOP_H
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2014, Julien Bernard
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#ifndef UI_RENDER_COMMAND_LIST_H
+#define UI_RENDER_COMMAND_LIST_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+
+namespace ui {
+
+  class Widget;
+
+  /**
+   * @brief The type of a render command.
+   *
+   * @ingroup widgets
+   */
+  enum class RenderCommandType : uint8_t {
+    RECTANGLE,  ///< a filled rectangle
+    OUTLINE,    ///< an outline of thickness 1 drawn around a rectangle
+    TEXT,       ///< a text run centered in a rectangle
+    CACHE,      ///< a cached bin that may be drawn from a previous rendering
+    CLIP_BEGIN, ///< the following commands are clipped to a rectangle
+    CLIP_END,   ///< the end of the last clip
+  };
+
+  /**
+   * @brief A render command.
+   *
+   * A render command is a plain structure that describes something to draw,
+   * independently of the drawing backend. The characters of a text run are
+   * stored in the command list.
+   *
+   * @ingroup widgets
+   */
+  struct RenderCommand {
+    RenderCommandType type; ///< the type of the command
+    bool focused; ///< the focus state of the widget
+    sf::FloatRect geometry; ///< the geometry of the command
+    sf::Color color; ///< the color of the command
+    Widget *widget; ///< the widget that emitted the command
+    std::size_t text_start; ///< the index of the first character of the text run in the list
+    std::size_t text_length; ///< the number of characters of the text run
+  };
+
+  /**
+   * @brief A list of render commands.
+   *
+   * The list is meant to be cleared and filled again each frame. Clearing
+   * the list keeps the allocated memory so that no allocation happens once
+   * the list has reached its steady size.
+   *
+   * @ingroup widgets
+   */
+  class RenderCommandList {
+  public:
+    /**
+     * @brief A constant iterator on the commands.
+     */
+    typedef std::vector<RenderCommand>::const_iterator const_iterator;
+
+    /**
+     * @brief Remove all the commands while keeping the memory.
+     */
+    void clear() {
+      m_commands.clear();
+      m_characters.clear();
+    }
+
+    /**
+     * @brief Add a filled rectangle.
+     *
+     * @param widget the widget that emits the command.
+     * @param geometry the rectangle.
+     * @param color the fill color.
+     */
+    void addRectangle(Widget& widget, const sf::FloatRect& geometry, const sf::Color& color);
+
+    /**
+     * @brief Add an outline around a rectangle.
+     *
+     * @param widget the widget that emits the command.
+     * @param geometry the rectangle.
+     * @param color the outline color.
+     * @param focused the focus state of the widget.
+     */
+    void addOutline(Widget& widget, const sf::FloatRect& geometry, const sf::Color& color, bool focused);
+
+    /**
+     * @brief Add a text run centered in a rectangle.
+     *
+     * @param widget the widget that emits the command.
+     * @param geometry the rectangle.
+     * @param color the text color.
+     * @param text the text.
+     */
+    void addText(Widget& widget, const sf::FloatRect& geometry, const sf::Color& color, const std::string& text);
+
+    /**
+     * @brief Add a cached bin.
+     *
+     * The consumer of the list may draw the bin from a previous rendering,
+     * or render its content with RenderVisitor::visitBinContent().
+     *
+     * @param widget the cached widget.
+     * @param geometry the geometry of the widget.
+     */
+    void addCache(Widget& widget, const sf::FloatRect& geometry);
+
+    /**
+     * @brief Begin to clip the following commands.
+     *
+     * The clips can be nested. The consumer of the list must intersect a
+     * new clip rectangle with the current one.
+     *
+     * @param widget the widget that emits the command.
+     * @param geometry the clip rectangle.
+     */
+    void addClipBegin(Widget& widget, const sf::FloatRect& geometry);
+
+    /**
+     * @brief End the last clip.
+     *
+     * @param widget the widget that emits the command.
+     */
+    void addClipEnd(Widget& widget);
+
+    /**
+     * @brief Get the number of commands.
+     *
+     * @return the number of commands in the list.
+     */
+    std::size_t getCommandCount() const {
+      return m_commands.size();
+    }
+
+    /**
+     * @brief Get an iterator to the first command.
+     *
+     * @return an iterator to the first command.
+     */
+    const_iterator begin() const {
+      return m_commands.begin();
+    }
+
+    /**
+     * @brief Get an iterator past the last command.
+     *
+     * @return an iterator past the last command.
+     */
+    const_iterator end() const {
+      return m_commands.end();
+    }
+
+    /**
+     * @brief Get the characters of a text run.
+     *
+     * The characters are not null-terminated, the length of the text run is
+     * given by the command.
+     *
+     * @param command a text command of this list.
+     * @return the first character of the text run.
+     */
+    const char *getText(const RenderCommand& command) const {
+      return m_characters.data() + command.text_start;
+    }
+
+    /**
+     * @brief Write a human-readable version of the list.
+     *
+     * Each command is written on its own line.
+     *
+     * @param out the output stream.
+     */
+    void dump(std::ostream& out) const;
+
+  private:
+    void addCommand(RenderCommandType type, Widget& widget, const sf::FloatRect& geometry, const sf::Color& color, bool focused);
+
+  private:
+    std::vector<RenderCommand> m_commands;
+    std::vector<char> m_characters;
+  };
+
+}
+
+#endif // UI_RENDER_COMMAND_LIST_H
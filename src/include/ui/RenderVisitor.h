@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2014, Julien Bernard
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#ifndef UI_RENDER_VISITOR_H
+#define UI_RENDER_VISITOR_H
+
+#include <ui/RenderCommandList.h>
+#include <ui/WidgetVisitor.h>
+
+namespace ui {
+
+  /**
+   * @brief A visitor that emits the render commands of the widgets.
+   *
+   * The visitor only walks the widgets and fills a command list. Drawing
+   * the commands is left to a backend, so that walking the widgets and
+   * submitting the drawing can be measured separately.
+   *
+   * The geometry of the commands is in the coordinates of the screen: the
+   * content of a scroll area is moved by its offset and clipped to it, and
+   * the cells of a list view or a grid view are clipped to it.
+   *
+   * @ingroup widgets
+   */
+  class RenderVisitor : public WidgetVisitor {
+  public:
+    /**
+     * @brief Construct a render visitor.
+     *
+     * @param commands the list where the commands are added.
+     */
+    RenderVisitor(RenderCommandList& commands)
+    : m_commands(commands)
+    {
+    }
+
+    /**
+     * @brief Emit the commands of a bin, even if it is cached.
+     *
+     * This function is useful to render the content of a cached bin.
+     *
+     * @param widget the bin widget.
+     */
+    void visitBinContent(Bin& widget);
+
+    virtual void visitArea(Area& widget) override;
+    virtual void visitBin(Bin& widget) override;
+    virtual void visitButton(Button& widget) override;
+    virtual void visitForm(Form& widget) override;
+    virtual void visitGridView(GridView& widget) override;
+    virtual void visitHBox(HBox& widget) override;
+    virtual void visitLabel(Label& widget) override;
+    virtual void visitListView(ListView& widget) override;
+    virtual void visitScrollArea(ScrollArea& widget) override;
+    virtual void visitSelect(Select& widget) override;
+    virtual void visitStack(Stack& widget) override;
+    virtual void visitTable(Table& widget) override;
+    virtual void visitToggle(Toggle& widget) override;
+    virtual void visitVBox(VBox& widget) override;
+
+  protected:
+    /**
+     * @brief Tell whether a widget is outside the clip rectangle.
+     *
+     * The outline of the widget, that is outside its geometry, is taken
+     * into account.
+     *
+     * @param widget the widget.
+     * @return true if nothing of the widget should be drawn.
+     */
+    virtual bool isCulled(const Widget& widget) const override;
+
+    /**
+     * @brief Emit a box: a filled rectangle and its outline.
+     */
+    void addBox(Widget& widget, const sf::FloatRect& geometry, const sf::Color& fill, const sf::Color& outline, bool focused);
+
+  private:
+    sf::FloatRect toScreen(const sf::FloatRect& geometry) const;
+
+  private:
+    RenderCommandList& m_commands;
+  };
+
+}
+
+#endif // UI_RENDER_VISITOR_H
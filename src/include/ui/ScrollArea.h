@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2014, Julien Bernard
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#ifndef UI_SCROLL_AREA_H
+#define UI_SCROLL_AREA_H
+
+#include <ui/Widget.h>
+
+namespace ui {
+
+  /**
+   * @brief A container that shows a part of a larger child.
+   *
+   * The child is laid out at its full size, in the coordinates of the
+   * content of the scroll area: at an offset of zero, the top-left corner
+   * of the content is the top-left corner of the scroll area. The scroll
+   * area then shows the part of the content at the current offset.
+   *
+   * Scrolling only changes the offset: the child is not laid out again.
+   * The visitors only visit the descendants that are inside the scroll
+   * area, and only these descendants can be clicked and focused. So when
+   * a leaf of the content gets the focus, the scroll area shows the leaf
+   * and the space around it, so that the focus can move to the next
+   * leaves.
+   *
+   * The size hint of a scroll area does not depend on its child. By
+   * default, its size policy is SizePolicy::MINIMUM so that it takes all
+   * the space given by its parent.
+   *
+   * @ingroup widgets
+   */
+  class ScrollArea : public Widget {
+  public:
+    /**
+     * @brief Construct an empty scroll area.
+     */
+    ScrollArea();
+
+    /**
+     * @brief Destroy the scroll area and its child.
+     */
+    virtual ~ScrollArea();
+
+    /**
+     * @brief Set the child of the scroll area.
+     *
+     * @param child the new child.
+     */
+    void setChild(Widget *child);
+
+    /**
+     * @brief Tell whether the scroll area has a child.
+     *
+     * @returns true if the scroll area has a child.
+     */
+    bool hasChild() const {
+      return m_child != nullptr;
+    }
+
+    /**
+     * @brief Get the child of the scroll area.
+     *
+     * @returns the child of the scroll area (or `nullptr` if there is none)
+     */
+    Widget *getChild() {
+      return m_child;
+    }
+
+    /**
+     * @name Scrolling
+     * @{
+     */
+    /**
+     * @brief Set the offset of the content.
+     *
+     * The offset is clamped so that the scroll area does not show anything
+     * past the content.
+     *
+     * @param offset the new offset.
+     */
+    void setOffset(const sf::Vector2f& offset);
+
+    /**
+     * @brief Get the offset of the content.
+     *
+     * @return the current offset.
+     */
+    const sf::Vector2f& getOffset() const {
+      return m_offset;
+    }
+
+    /**
+     * @brief Move the content.
+     *
+     * @param delta the change of the offset.
+     */
+    void scroll(const sf::Vector2f& delta) {
+      setOffset(m_offset + delta);
+    }
+
+    /**
+     * @brief Change the offset so that a rectangle of the content is shown.
+     *
+     * If the rectangle is larger than the scroll area, its top-left corner
+     * is shown.
+     *
+     * @param rectangle a rectangle in the coordinates of the content.
+     */
+    void scrollTo(const sf::FloatRect& rectangle);
+
+    /**
+     * @brief Get the size of the content.
+     *
+     * @return the size of the child after the layout.
+     */
+    sf::Vector2f getContentSize() const;
+
+    /**
+     * @brief Get the visible part of the content.
+     *
+     * @return the visible rectangle in the coordinates of the content.
+     */
+    sf::FloatRect getVisibleContent() const;
+    /** @} */
+
+    virtual void onClick(sf::Mouse::Button button, const sf::Vector2f& mouse) override;
+
+    virtual void layoutRequest() override;
+
+    virtual void layoutAllocation() override;
+
+    /**
+     * @brief Add a damaged rectangle of the content.
+     *
+     * The rectangle is moved to the place where the content is shown and
+     * clipped to the scroll area before being forwarded to the parent.
+     *
+     * @param rectangle the damaged rectangle, in the coordinates of the
+     * content.
+     */
+    virtual void addDamage(const sf::FloatRect& rectangle) override;
+
+    virtual void childFocusChanged(Widget& child, Leaf& leaf, bool focused) override;
+
+    virtual void accept(WidgetVisitor& visitor) override;
+
+  private:
+    sf::Vector2f clampOffset(const sf::Vector2f& offset) const;
+    sf::FloatRect revealRectangle(const sf::FloatRect& rectangle) const;
+
+  private:
+    Widget *m_child;
+    sf::Vector2f m_offset;
+
+    sf::FloatRect m_reveal; // in the coordinates of the content
+    bool m_reveal_needed;
+  };
+
+}
+
+#endif // UI_SCROLL_AREA_H
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2014, Julien Bernard
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#ifndef UI_SOFTWARE_RENDERER_H
+#define UI_SOFTWARE_RENDERER_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <ui/RenderCommandList.h>
+
+namespace ui {
+
+  /**
+   * @brief A renderer that rasterizes the widgets in memory.
+   *
+   * The renderer does not need a graphics context: rectangles and outlines
+   * are filled span by span in an RGBA buffer. Text runs are not drawn.
+   * It is useful for benchmarks and tests on machines without a GPU, or to
+   * render thumbnails on a server.
+   *
+   * The pixels are stored row by row, with four bytes per pixel in the
+   * red, green, blue, alpha order, as expected by `sf::Image::create()`.
+   *
+   * @ingroup widgets
+   */
+  class SoftwareRenderer {
+  public:
+    /**
+     * @brief Construct a software renderer.
+     *
+     * @param width the width of the buffer in pixels.
+     * @param height the height of the buffer in pixels.
+     */
+    SoftwareRenderer(unsigned width, unsigned height);
+
+    /**
+     * @brief Change the size of the buffer.
+     *
+     * The content of the buffer is lost.
+     *
+     * @param width the new width of the buffer in pixels.
+     * @param height the new height of the buffer in pixels.
+     */
+    void resize(unsigned width, unsigned height);
+
+    /**
+     * @brief Get the width of the buffer.
+     *
+     * @return the width of the buffer in pixels.
+     */
+    unsigned getWidth() const {
+      return m_width;
+    }
+
+    /**
+     * @brief Get the height of the buffer.
+     *
+     * @return the height of the buffer in pixels.
+     */
+    unsigned getHeight() const {
+      return m_height;
+    }
+
+    /**
+     * @brief Get the pixels of the buffer.
+     *
+     * @return a pointer to the first byte of the buffer.
+     */
+    const uint8_t *getPixels() const {
+      return reinterpret_cast<const uint8_t *>(m_pixels.data());
+    }
+
+    /**
+     * @brief Get the color of a pixel.
+     *
+     * @param x the column of the pixel.
+     * @param y the row of the pixel.
+     * @return the color of the pixel.
+     */
+    sf::Color getPixel(unsigned x, unsigned y) const;
+
+    /**
+     * @brief Fill the whole buffer with a color.
+     *
+     * @param color the color.
+     */
+    void clear(const sf::Color& color);
+
+    /**
+     * @brief Draw a widget and its descendants.
+     *
+     * @param widget the widget.
+     */
+    void draw(Widget& widget);
+
+    /**
+     * @brief Draw a list of commands.
+     *
+     * Cached bins are drawn as if they were not cached. The commands
+     * between a clip begin and its end are clipped.
+     *
+     * @param commands the commands.
+     */
+    void draw(const RenderCommandList& commands);
+
+    /**
+     * @brief Fill a rectangle.
+     *
+     * A pixel is filled if its center is inside the rectangle and inside
+     * the current clip of the drawn commands.
+     *
+     * @param geometry the rectangle.
+     * @param color the color.
+     */
+    void fillRectangle(const sf::FloatRect& geometry, const sf::Color& color);
+
+    /**
+     * @brief Draw an outline of thickness 1 around a rectangle.
+     *
+     * @param geometry the rectangle.
+     * @param color the color.
+     */
+    void drawOutline(const sf::FloatRect& geometry, const sf::Color& color);
+
+  private:
+    void fillSpan(uint32_t *span, std::size_t length, const sf::Color& color);
+    sf::FloatRect move(const sf::FloatRect& geometry) const;
+
+  private:
+    unsigned m_width;
+    unsigned m_height;
+    std::vector<uint32_t> m_pixels;
+    RenderCommandList m_commands;
+    std::vector<std::unique_ptr<RenderCommandList>> m_cache_commands; // one per level of nested caches
+    std::size_t m_cache_depth;
+    std::vector<sf::FloatRect> m_clips;
+    sf::Vector2f m_offset;
+  };
+
+}
+
+#endif // UI_SOFTWARE_RENDERER_H
@@ -40,14 +40,27 @@ namespace ui {
      */
     void addChild(Widget *widget) {
       m_children.push(widget);
+      widget->setParent(this);
+      invalidateLayout();
+      invalidateFocus();
+
+      // the previous top child is hidden
+      invalidateRendering();
     }
 
     /**
      * @brief Remove the top child.
      */
     void removeChild() {
+      // the child below may have the same geometry, so the removed child
+      // would not be damaged by the layout
+      addDamage(m_children.top()->getGeometry());
+
       delete m_children.top();
       m_children.pop();
+      invalidateLayout();
+      invalidateFocus();
+      invalidateRendering();
     }
 
     /**
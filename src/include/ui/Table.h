@@ -73,6 +73,7 @@ namespace ui {
      */
     void setHorizontalGap(float gap) {
       m_hgap = gap;
+      invalidateLayout();
     }
 
     /**
@@ -91,6 +92,7 @@ namespace ui {
      */
     void setVerticalGap(float gap) {
       m_vgap = gap;
+      invalidateLayout();
     }
 
     /**
@@ -102,6 +104,14 @@ namespace ui {
       return m_vgap;
     }
 
+    /**
+     * @brief Dispatch a click to the child under the mouse.
+     *
+     * The row and the column under the mouse are found with a binary search
+     * in the geometry of the rows and columns computed during the layout.
+     */
+    virtual void onClick(sf::Mouse::Button button, const sf::Vector2f& mouse) override;
+
     virtual void layoutRequest() override;
 
     virtual void layoutAllocation() override;
@@ -50,6 +50,7 @@ namespace ui {
      */
     void setSelected(bool selected = true) {
       m_selected = selected;
+      invalidateRendering();
     }
 
     /**
@@ -57,6 +58,7 @@ namespace ui {
      */
     void switchSelection() {
       m_selected = !m_selected;
+      invalidateRendering();
     }
 
     virtual void onClick(sf::Mouse::Button button, const sf::Vector2f& mouse) override;
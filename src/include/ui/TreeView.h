@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2014, Julien Bernard
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#ifndef UI_TREE_VIEW_H
+#define UI_TREE_VIEW_H
+
+#include <vector>
+
+#include <ui/ListView.h>
+
+namespace ui {
+
+  /**
+   * @brief The nodes of a tree view.
+   *
+   * The model gives the children of a node when the node is expanded, and
+   * creates the widgets that show the nodes. A node is identified by a
+   * number chosen by the model, e.g. an index in its own storage.
+   *
+   * @sa TreeView
+   */
+  class TreeModel {
+  public:
+    /**
+     * @brief The identifier of a node.
+     */
+    typedef std::size_t Node;
+
+    /**
+     * @brief The parent of the top-level nodes.
+     */
+    static constexpr Node Root = static_cast<Node>(-1);
+
+    /**
+     * @brief Destroy the model.
+     */
+    virtual ~TreeModel();
+
+    /**
+     * @brief Tell whether a node has children.
+     *
+     * This function is called for each shown node, so it should not
+     * compute the children.
+     *
+     * @param node the node.
+     * @return true if the node can be expanded.
+     */
+    virtual bool hasChildren(Node node) const = 0;
+
+    /**
+     * @brief Get the children of a node.
+     *
+     * This function is called when the node is expanded.
+     *
+     * @param node the node, or Root for the top-level nodes.
+     * @param children the vector where the children are added.
+     */
+    virtual void getChildren(Node node, std::vector<Node>& children) = 0;
+
+    /**
+     * @brief Create a new row widget.
+     *
+     * The widget is owned by the tree view.
+     *
+     * @return a new row widget.
+     */
+    virtual Widget *createRow() = 0;
+
+    /**
+     * @brief Show a node in a row widget.
+     *
+     * The widget may have shown another node before, so all its state must
+     * be set, including the focus state of its focusable leaf.
+     *
+     * @param widget a widget created by createRow().
+     * @param row the index of the row, e.g. to call TreeView::toggle().
+     * @param node the node to show.
+     * @param depth the depth of the node, 0 for a top-level node.
+     * @param expanded true if the node is expanded.
+     * @param focused true if the row contains the focused leaf.
+     */
+    virtual void updateRow(Widget& widget, std::size_t row, Node node, unsigned depth, bool expanded, bool focused) = 0;
+  };
+
+  /**
+   * @brief A tree whose nodes are shown on demand.
+   *
+   * The tree view is a list view whose rows are the shown nodes, i.e. the
+   * top-level nodes and the descendants of the expanded nodes. The
+   * children of a node are asked to the model when the node is expanded,
+   * and forgotten when it is collapsed. So the cost of the tree view only
+   * depends on the shown nodes, and only the visible ones have a widget.
+   *
+   * Expanding or collapsing a node only changes the rows after this node.
+   * The change is applied at the next layout update, so it is safe to
+   * expand or collapse a node from the callback of its row.
+   *
+   * @ingroup widgets
+   */
+  class TreeView : private ListModel, public ListView {
+  public:
+    /**
+     * @brief Construct a tree view with the top-level nodes.
+     *
+     * The model is not owned by the tree view, it must live as long as the
+     * tree view.
+     *
+     * @param model the model of the nodes.
+     * @param row_height the height of a row.
+     */
+    TreeView(TreeModel& model, float row_height);
+
+    /**
+     * @brief Get the number of shown nodes.
+     *
+     * @return the number of rows of the tree view.
+     */
+    std::size_t getShownNodeCount() const {
+      return m_entries.size();
+    }
+
+    /**
+     * @brief Get the node of a row.
+     *
+     * @param row the index of the row.
+     * @return the node shown in the row.
+     */
+    TreeModel::Node getNode(std::size_t row) const {
+      return m_entries[row].node;
+    }
+
+    /**
+     * @brief Get the depth of the node of a row.
+     *
+     * @param row the index of the row.
+     * @return the depth of the node, 0 for a top-level node.
+     */
+    unsigned getDepth(std::size_t row) const {
+      return m_entries[row].depth;
+    }
+
+    /**
+     * @brief Tell whether the node of a row is expanded.
+     *
+     * @param row the index of the row.
+     * @return true if the node is expanded.
+     */
+    bool isExpanded(std::size_t row) const {
+      return m_entries[row].expanded;
+    }
+
+    /**
+     * @brief Show the children of the node of a row.
+     *
+     * @param row the index of the row.
+     */
+    void expand(std::size_t row);
+
+    /**
+     * @brief Hide the descendants of the node of a row.
+     *
+     * @param row the index of the row.
+     */
+    void collapse(std::size_t row);
+
+    /**
+     * @brief Expand or collapse the node of a row.
+     *
+     * @param row the index of the row.
+     */
+    void toggle(std::size_t row);
+
+    /**
+     * @brief Tell that the nodes of the model have changed.
+     *
+     * The top-level nodes are asked again to the model and all the nodes
+     * are collapsed.
+     */
+    void invalidateNodes();
+
+  private:
+    virtual std::size_t getRowCount() const override;
+    virtual Widget *createRow() override;
+    virtual void updateRow(Widget& widget, std::size_t index, bool focused) override;
+
+    std::size_t findSubtreeEnd(std::size_t row) const;
+
+  private:
+    struct Entry {
+      TreeModel::Node node;
+      unsigned depth;
+      bool expanded;
+    };
+
+    TreeModel& m_model;
+    std::vector<Entry> m_entries;
+    std::vector<TreeModel::Node> m_children;
+  };
+
+}
+
+#endif // UI_TREE_VIEW_H
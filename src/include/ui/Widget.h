@@ -24,6 +24,7 @@
 
 namespace ui {
 
+  class Leaf;
   class WidgetVisitor;
 
   /**
@@ -37,8 +38,11 @@ namespace ui {
      * @brief Construct a widget.
      */
     Widget()
+    : m_parent(nullptr)
+    , m_layout_request_needed(true)
+    , m_layout_allocation_needed(true)
+    , m_rendering_version(0)
     {
-      // empty but a default constructor is needed for children classes
     }
 
     Widget(const Widget&) = delete;
@@ -64,6 +68,7 @@ namespace ui {
     void setSizeHint(float width, float height) {
       m_horizontal.hint = width;
       m_vertical.hint = height;
+      invalidateLayout();
     }
 
     /**
@@ -82,6 +87,7 @@ namespace ui {
      */
     void setHorizontalPolicy(SizePolicy policy) {
       m_horizontal.policy = policy;
+      invalidateLayout();
     }
 
     /**
@@ -91,6 +97,7 @@ namespace ui {
      */
     void setVerticalPolicy(SizePolicy policy) {
       m_vertical.policy = policy;
+      invalidateLayout();
     }
 
     /**
@@ -111,6 +118,7 @@ namespace ui {
      */
     void setHorizontalAlignment(Alignment alignment) {
       m_horizontal.alignment = alignment;
+      invalidateLayout();
     }
 
     /**
@@ -120,6 +128,7 @@ namespace ui {
      */
     void setVerticalAlignment(Alignment alignment) {
       m_vertical.alignment = alignment;
+      invalidateLayout();
     }
 
     /**
@@ -190,6 +199,105 @@ namespace ui {
     /** @} */
 
 
+    /**
+     * @name Hierarchy
+     * @{
+     */
+    /**
+     * @brief Get the parent of the widget.
+     *
+     * @return the parent of the widget or `nullptr` if the widget has no parent.
+     */
+    Widget *getParent() {
+      return m_parent;
+    }
+
+    /**
+     * @brief Set the parent of the widget.
+     *
+     * This function is called by the widgets that own children. You should
+     * not have to call it yourself.
+     *
+     * @param parent the new parent of the widget.
+     */
+    void setParent(Widget *parent) {
+      m_parent = parent;
+    }
+
+    /**
+     * @brief Tell that the focusable widgets of the hierarchy have changed.
+     *
+     * By default, the notification is forwarded to the parent of the widget.
+     * This function is called automatically when a child is added or removed
+     * and when the focus state of a leaf changes.
+     *
+     * @sa Area
+     */
+    virtual void invalidateFocus();
+
+    /**
+     * @brief Tell that the focus state of a leaf in the hierarchy has changed.
+     *
+     * By default, the notification is forwarded to the parent of the widget.
+     * This function is called automatically when the focus state of a leaf
+     * changes, so that the widgets that recycle their children know which
+     * child contains the focused leaf, and the widgets that scroll their
+     * content can show the focused leaf.
+     *
+     * @param child the child of the widget that contains the leaf.
+     * @param leaf the leaf whose focus state has changed.
+     * @param focused the new focus state of the leaf.
+     *
+     * @sa ListView, GridView, ScrollArea
+     */
+    virtual void childFocusChanged(Widget& child, Leaf& leaf, bool focused);
+    /** @} */
+
+
+    /**
+     * @name Rendering
+     * @{
+     */
+    /**
+     * @brief Tell that the appearance of the widget has changed.
+     *
+     * The rendering version of the widget and of all its ancestors is
+     * incremented and the geometry of the widget is added to the damaged
+     * region. This function is called automatically when the state of
+     * a widget changes (selection, focus) and when its geometry changes.
+     *
+     * @sa getRenderingVersion(), addDamage()
+     */
+    void invalidateRendering();
+
+    /**
+     * @brief Tell that a part of the screen must be drawn again.
+     *
+     * The rectangle is in the coordinates of the children of the widget. By
+     * default, the damaged rectangle is forwarded to the parent of the
+     * widget.
+     *
+     * @param rectangle the damaged rectangle.
+     *
+     * @sa Area, ScrollArea
+     */
+    virtual void addDamage(const sf::FloatRect& rectangle);
+
+    /**
+     * @brief Get the rendering version of the widget.
+     *
+     * The rendering version changes each time the appearance of the widget
+     * or of one of its descendants changes. A renderer can compare it with
+     * a previous value to know if a cached rendering is still valid.
+     *
+     * @return the rendering version of the widget.
+     */
+    unsigned long getRenderingVersion() const {
+      return m_rendering_version;
+    }
+    /** @} */
+
+
     /**
      * @name Interactions
      * @{
@@ -230,6 +338,69 @@ namespace ui {
      * of the widget. This is a top-down process.
      */
     virtual void layoutAllocation() = 0;
+
+    /**
+     * @brief Tell that the layout of the widget must be computed again.
+     *
+     * The widget and all its ancestors are marked so that the next layout
+     * update recomputes them. This function is called automatically when a
+     * property that influences the layout is changed.
+     *
+     * @sa Area::updateLayout()
+     */
+    void invalidateLayout();
+
+    /**
+     * @brief Tell whether the size hint of the widget must be computed again.
+     *
+     * @return true if the size hint of the widget is outdated.
+     */
+    bool isLayoutRequestNeeded() const {
+      return m_layout_request_needed;
+    }
+
+    /**
+     * @brief Tell whether the size of the widget must be computed again.
+     *
+     * @return true if the size of the widget is outdated.
+     */
+    bool isLayoutAllocationNeeded() const {
+      return m_layout_allocation_needed;
+    }
+
+    /**
+     * @brief Compute the size hint of the widget if needed.
+     *
+     * layoutRequest() is called only if the widget has been invalidated since
+     * the last call. Widgets with children must call this function on their
+     * children in their own layoutRequest().
+     *
+     * @sa layoutRequest(), invalidateLayout()
+     */
+    void updateLayoutRequest();
+
+    /**
+     * @brief Compute the size of the widget if needed.
+     *
+     * layoutAllocation() is called only if the widget has been invalidated or
+     * if its geometry has changed since the last call. Widgets with children
+     * must call this function on their children in their own
+     * layoutAllocation().
+     *
+     * @sa layoutAllocation(), invalidateLayout()
+     */
+    void updateLayoutAllocation();
+
+    /**
+     * @brief Get the number of layout allocations since the beginning.
+     *
+     * This counter is incremented each time a widget is actually laid out by
+     * updateLayoutAllocation(). It is useful to measure the cost of a layout
+     * update.
+     *
+     * @return the number of layout allocations.
+     */
+    static std::size_t getLayoutAllocationCount();
     /** @} */
 
     /**
@@ -240,8 +411,16 @@ namespace ui {
     virtual void accept(WidgetVisitor& visitor) = 0;
 
   private:
+    void addOwnDamage(const sf::FloatRect& rectangle);
+
+  private:
+    Widget *m_parent;
     Geometry m_horizontal;
     Geometry m_vertical;
+    bool m_layout_request_needed;
+    bool m_layout_allocation_needed;
+    sf::FloatRect m_allocated_geometry;
+    unsigned long m_rendering_version;
   };
 
 }
@@ -20,8 +20,11 @@
 #include <ui/Bin.h>
 #include <ui/Button.h>
 #include <ui/Form.h>
+#include <ui/GridView.h>
 #include <ui/HBox.h>
 #include <ui/Label.h>
+#include <ui/ListView.h>
+#include <ui/ScrollArea.h>
 #include <ui/Select.h>
 #include <ui/Stack.h>
 #include <ui/Toggle.h>
@@ -32,15 +35,91 @@ namespace ui {
   /**
    * @brief A widget visitor.
    *
+   * A visitor can have a clip rectangle. In this case, the helpers do not
+   * visit the children that are culled, i.e. that are outside the clip
+   * rectangle, nor their descendants.
+   *
+   * The descendants of a scroll area are visited in the coordinates of its
+   * content. The translation gives the difference between these coordinates
+   * and the coordinates of the screen.
+   *
    * @ingroup widgets
    */
   class WidgetVisitor {
   public:
+    /**
+     * @brief Construct a visitor without a clip rectangle.
+     */
+    WidgetVisitor()
+    : m_clip(nullptr)
+    , m_culled_count(0)
+    , m_translation(0.0f, 0.0f)
+    {
+    }
+
     /**
      * @brief Destroy the visitor.
      */
     virtual ~WidgetVisitor();
 
+    /**
+     * @name Culling
+     * @{
+     */
+    /**
+     * @brief Set the clip rectangle.
+     *
+     * The rectangle is not copied, it must live as long as it is used by
+     * the visitor.
+     *
+     * @param clip the clip rectangle or `nullptr` for no clipping.
+     */
+    void setClip(const sf::FloatRect *clip) {
+      m_clip = clip;
+    }
+
+    /**
+     * @brief Get the clip rectangle.
+     *
+     * @return the clip rectangle or `nullptr` if there is no clipping.
+     */
+    const sf::FloatRect *getClip() const {
+      return m_clip;
+    }
+
+    /**
+     * @brief Get the number of culled widgets.
+     *
+     * The descendants of a culled widget are not visited and are not
+     * counted.
+     *
+     * @return the number of widgets culled since the last reset.
+     */
+    std::size_t getCulledCount() const {
+      return m_culled_count;
+    }
+
+    /**
+     * @brief Reset the number of culled widgets.
+     */
+    void resetCulledCount() {
+      m_culled_count = 0;
+    }
+
+    /**
+     * @brief Get the current translation.
+     *
+     * The translation is the sum of the offsets of the scroll areas that
+     * contain the visited widget. The position of the widget on the screen
+     * is its geometry minus the translation.
+     *
+     * @return the current translation.
+     */
+    const sf::Vector2f& getTranslation() const {
+      return m_translation;
+    }
+    /** @} */
+
     /**
      * @brief Visit an area widget.
      *
@@ -69,6 +148,13 @@ namespace ui {
      */
     virtual void visitForm(Form& widget);
 
+    /**
+     * @brief Visit a grid view widget.
+     *
+     * @param widget the grid view widget.
+     */
+    virtual void visitGridView(GridView& widget);
+
     /**
      * @brief Visit a horizontal box widget.
      *
@@ -83,6 +169,20 @@ namespace ui {
      */
     virtual void visitLabel(Label& widget);
 
+    /**
+     * @brief Visit a list view widget.
+     *
+     * @param widget the list view widget.
+     */
+    virtual void visitListView(ListView& widget);
+
+    /**
+     * @brief Visit a scroll area widget.
+     *
+     * @param widget the scroll area widget.
+     */
+    virtual void visitScrollArea(ScrollArea& widget);
+
     /**
      * @brief Visit a select widget.
      *
@@ -140,6 +240,35 @@ namespace ui {
      */
     void visitContainerChildren(Container& widget);
 
+    /**
+     * @brief Visit the visible cells of a grid view.
+     *
+     * The focused cell, if it is scrolled out, is counted as culled.
+     *
+     * @param widget the grid view widget.
+     */
+    void visitGridViewCells(GridView& widget);
+
+    /**
+     * @brief Visit the visible rows of a list view.
+     *
+     * The focused row, if it is scrolled out, is counted as culled.
+     *
+     * @param widget the list view widget.
+     */
+    void visitListViewRows(ListView& widget);
+
+    /**
+     * @brief Visit the scroll area child.
+     *
+     * This function verifies that the child exists. During the visit of the
+     * child, the clip rectangle is restricted to the visible part of the
+     * content and the translation includes the offset of the scroll area.
+     *
+     * @param widget the scroll area widget.
+     */
+    void visitScrollAreaChild(ScrollArea& widget);
+
     /**
      * @brief Visit the stack top child.
      *
@@ -149,8 +278,27 @@ namespace ui {
      */
     void visitStackTopChild(Stack& widget);
 
+    /**
+     * @brief Tell whether a widget is outside the clip rectangle.
+     *
+     * By default, a widget is culled if its geometry does not intersect the
+     * clip rectangle. A visitor that draws outside the geometry of the
+     * widgets can take it into account.
+     *
+     * @param widget the widget.
+     * @return true if the widget must not be visited.
+     */
+    virtual bool isCulled(const Widget& widget) const;
+
     /** @} */
 
+  private:
+    void visitChild(Widget& widget);
+
+  private:
+    const sf::FloatRect *m_clip;
+    std::size_t m_culled_count;
+    sf::Vector2f m_translation;
   };
 
 }
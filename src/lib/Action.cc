@@ -21,9 +21,13 @@
 
 namespace ui {
 
+  static std::size_t g_control_addition_count = 0;
+
   Action::Action(std::string name)
   : m_name(std::move(name))
   , m_type(Type::INSTANTANEOUS)
+  , m_mask_complete(true)
+  , m_mask_needed(true)
   {
   }
 
@@ -44,44 +48,123 @@ namespace ui {
   }
 
   void Action::addGamepadAxisControl(unsigned int id, sf::Joystick::Axis axis, Direction dir) {
-    std::unique_ptr<Control> ptr(new GamepadAxisControl(id, axis, dir));
-    m_controls.push_back(std::move(ptr));
+    m_gamepad_axis_controls.emplace_back(id, axis, dir);
+    controlAdded();
   }
 
   void Action::addGamepadButtonControl(unsigned int id, unsigned int button) {
-    std::unique_ptr<Control> ptr(new GamepadButtonControl(id, button));
-    m_controls.push_back(std::move(ptr));
+    m_gamepad_button_controls.emplace_back(id, button);
+    controlAdded();
   }
 
   void Action::addKeyControl(sf::Keyboard::Key key) {
-    std::unique_ptr<Control> ptr(new KeyControl(key));
-    m_controls.push_back(std::move(ptr));
+    m_key_controls.emplace_back(key);
+    controlAdded();
   }
 
   void Action::addMouseButtonControl(sf::Mouse::Button button) {
-    std::unique_ptr<Control> ptr(new MouseButtonControl(button));
-    m_controls.push_back(std::move(ptr));
+    m_mouse_button_controls.emplace_back(button);
+    controlAdded();
   }
 
   void Action::addCloseControl() {
-    std::unique_ptr<Control> ptr(new CloseControl);
-    m_controls.push_back(std::move(ptr));
+    m_close_controls.emplace_back();
+    controlAdded();
   }
 
-  void Action::update(const sf::Event& event) {
-    for (auto& control : m_controls) {
-      control->update(event);
+  void Action::controlAdded() {
+    // the pool may have moved, so the action sets must index the controls again
+    m_mask_needed = true;
+    ++g_control_addition_count;
+  }
+
+  std::size_t Action::getControlCount() const {
+    return m_gamepad_axis_controls.size() + m_gamepad_button_controls.size() + m_key_controls.size()
+        + m_mouse_button_controls.size() + m_close_controls.size();
+  }
+
+  Control& Action::ithControl(std::size_t i) {
+    if (i < m_gamepad_axis_controls.size()) {
+      return m_gamepad_axis_controls[i];
+    }
+
+    i -= m_gamepad_axis_controls.size();
+
+    if (i < m_gamepad_button_controls.size()) {
+      return m_gamepad_button_controls[i];
     }
+
+    i -= m_gamepad_button_controls.size();
+
+    if (i < m_key_controls.size()) {
+      return m_key_controls[i];
+    }
+
+    i -= m_key_controls.size();
+
+    if (i < m_mouse_button_controls.size()) {
+      return m_mouse_button_controls[i];
+    }
+
+    i -= m_mouse_button_controls.size();
+    return m_close_controls.at(i);
+  }
+
+  std::size_t Action::getControlAdditionCount() {
+    return g_control_addition_count;
+  }
+
+  void Action::update(const sf::Event& event) {
+    forEachControl([&event](Control& control) {
+      control.update(event);
+    });
   }
 
   bool Action::isActive() {
-    for (auto& control : m_controls) {
-      if (control->isActive()) {
-        return true;
-      }
+    bool active = false;
+
+    forEachControl([&active](Control& control) {
+      active = active || control.isActive();
+    });
+
+    return active;
+  }
+
+  bool Action::isActive(const InputState& state) {
+    updateMask();
+
+    InputState::Mask active = state.getPressed() & m_mask;
+
+    if (isInstantaneous()) {
+      active &= state.getJustPressed();
+    }
+
+    if (active.any()) {
+      return true;
     }
 
-    return false;
+    return !m_mask_complete && isActive();
+  }
+
+  void Action::updateMask() {
+    if (!m_mask_needed) {
+      return;
+    }
+
+    m_mask.reset();
+    m_mask_complete = true;
+
+    forEachControl([this](Control& control) {
+      std::size_t index = InputState::getIndex(control.getEventSource());
+
+      if (index == InputState::NoIndex) {
+        m_mask_complete = false;
+      } else {
+        m_mask.set(index);
+      }
+    });
+
+    m_mask_needed = false;
   }
 
   void Action::reset() {
@@ -89,79 +172,143 @@ namespace ui {
       return;
     }
 
-    for (auto& control : m_controls) {
-      control->reset();
-    }
+    forEachControl([](Control& control) {
+      control.reset();
+    });
   }
 
   // ActionSet
 
+  ActionSet::ActionSet()
+  : m_control_addition_count(0)
+  , m_dispatch_needed(true)
+  {
+  }
+
   void ActionSet::addAction(std::shared_ptr<Action> action) {
     m_actions.push_back(action);
+    m_dispatch_needed = true;
+  }
+
+  ActionSet::Handle ActionSet::createAction(std::string name) {
+    Handle handle = m_owned_actions.size();
+    m_owned_actions.emplace_back(std::move(name));
+    m_dispatch_needed = true;
+    return handle;
   }
 
   void ActionSet::update(const sf::Event& event) {
-    for (auto action : m_actions) {
-      action->update(event);
+    updateDispatch();
+
+    for (auto control : m_any_controls) {
+      control->update(event);
+    }
+
+    EventSource source = EventSource::fromEvent(event);
+
+    if (source.type == EventSource::Type::ANY) {
+      return;
+    }
+
+    auto it = m_dispatch.find(source);
+
+    if (it == m_dispatch.end()) {
+      return;
     }
+
+    for (auto control : it->second) {
+      control->update(event);
+    }
+  }
+
+  void ActionSet::updateDispatch() {
+    // controls may have been added to the actions after they were added to the set
+    if (!m_dispatch_needed && m_control_addition_count == Action::getControlAdditionCount()) {
+      return;
+    }
+
+    m_dispatch.clear();
+    m_any_controls.clear();
+
+    auto addControls = [this](Action& action) {
+      for (std::size_t i = 0; i < action.getControlCount(); ++i) {
+        Control& control = action.ithControl(i);
+        EventSource source = control.getEventSource();
+
+        if (source.type == EventSource::Type::ANY) {
+          m_any_controls.push_back(&control);
+        } else {
+          m_dispatch[source].push_back(&control);
+        }
+      }
+    };
+
+    for (auto& action : m_actions) {
+      addControls(*action);
+    }
+
+    for (auto& action : m_owned_actions) {
+      addControls(action);
+    }
+
+    m_control_addition_count = Action::getControlAdditionCount();
+    m_dispatch_needed = false;
   }
 
   void ActionSet::reset() {
-    for (auto action : m_actions) {
+    for (auto& action : m_actions) {
       action->reset();
     }
+
+    for (auto& action : m_owned_actions) {
+      action.reset();
+    }
   }
 
   // StandardActionSet
 
   StandardActionSet::StandardActionSet() {
-    m_up = std::make_shared<ui::Action>("Up");
-    m_up->addKeyControl(sf::Keyboard::Up);
-    addAction(m_up);
+    m_up = createAction("Up");
+    getAction(m_up).addKeyControl(sf::Keyboard::Up);
 
-    m_down = std::make_shared<ui::Action>("Down");
-    m_down->addKeyControl(sf::Keyboard::Down);
-    addAction(m_down);
+    m_down = createAction("Down");
+    getAction(m_down).addKeyControl(sf::Keyboard::Down);
 
-    m_left = std::make_shared<ui::Action>("Left");
-    m_left->addKeyControl(sf::Keyboard::Left);
-    addAction(m_left);
+    m_left = createAction("Left");
+    getAction(m_left).addKeyControl(sf::Keyboard::Left);
 
-    m_right = std::make_shared<ui::Action>("Right");
-    m_right->addKeyControl(sf::Keyboard::Right);
-    addAction(m_right);
+    m_right = createAction("Right");
+    getAction(m_right).addKeyControl(sf::Keyboard::Right);
 
-    m_primary = std::make_shared<ui::Action>("Primary");
-    m_primary->addKeyControl(sf::Keyboard::Return);
-    addAction(m_primary);
+    m_primary = createAction("Primary");
+    getAction(m_primary).addKeyControl(sf::Keyboard::Return);
 
-    m_secondary = std::make_shared<ui::Action>("Secondary");
-    m_secondary->addKeyControl(sf::Keyboard::BackSpace);
-    addAction(m_secondary);
+    m_secondary = createAction("Secondary");
+    getAction(m_secondary).addKeyControl(sf::Keyboard::BackSpace);
   }
 
   void StandardActionSet::handleArea(Area& area) {
-    if (m_down->isActive()) {
+    if (isActive(m_down)) {
       area.onDown();
     }
 
-    if (m_up->isActive()) {
+    if (isActive(m_up)) {
       area.onUp();
     }
 
-    if (m_left->isActive()) {
+    if (isActive(m_left)) {
       area.onLeft();
     }
 
-    if (m_right->isActive()) {
+    if (isActive(m_right)) {
       area.onRight();
     }
 
-    if (m_primary->isActive()) {
+    if (isActive(m_primary)) {
       area.onPrimaryAction();
     }
 
-    if (m_secondary->isActive()) {
+    if (isActive(m_secondary)) {
       area.onSecondaryAction();
     }
   }
@@ -15,6 +15,7 @@
  */
 #include <ui/Area.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <iostream>
@@ -28,10 +29,8 @@ namespace ui {
     return x * x;
   }
 
-  static float squared_distance(Leaf *lhs, Leaf *rhs) {
-    auto lhs_center = lhs->getCenter();
-    auto rhs_center = rhs->getCenter();
-    return square(lhs_center.x - rhs_center.x) + square(lhs_center.y - rhs_center.y);
+  static float squared_distance(const sf::Vector2f& lhs, const sf::Vector2f& rhs) {
+    return square(lhs.x - rhs.x) + square(lhs.y - rhs.y);
   }
 
   static bool isUpOrDown(const sf::Vector2f& focused, const sf::Vector2f& other) {
@@ -42,9 +41,40 @@ namespace ui {
     return std::abs(focused.x - other.x) >= std::abs(focused.y - other.y);
   }
 
+  namespace {
+    enum {
+      UP    = 0,
+      DOWN  = 1,
+      LEFT  = 2,
+      RIGHT = 3,
+    };
+  }
+
+  static bool isInDirection(std::size_t direction, const sf::Vector2f& focused, const sf::Vector2f& other) {
+    switch (direction) {
+      case UP:
+        return other.y < focused.y && isUpOrDown(focused, other);
+      case DOWN:
+        return other.y > focused.y && isUpOrDown(focused, other);
+      case LEFT:
+        return other.x < focused.x && isLeftOrRight(focused, other);
+      case RIGHT:
+        return other.x > focused.x && isLeftOrRight(focused, other);
+    }
+
+    assert(false);
+    return false;
+  }
+
   namespace {
     class FocusableList : public WidgetVisitor {
     public:
+      FocusableList(std::vector<Leaf*>& list, std::vector<sf::Vector2f>& list_translations)
+      : focusable(list)
+      , translations(list_translations)
+      {
+      }
+
       virtual void visitArea(Area& widget) override {
         visitStackTopChild(widget);
       }
@@ -78,6 +108,47 @@ namespace ui {
         // not focusable
       }
 
+      virtual void visitGridView(GridView& widget) override {
+        // the widgets of the cells that are not visible are not focusable
+        visitGridViewCells(widget);
+
+        if (hidden_search) {
+          Widget *cell = widget.getHiddenFocusedCell();
+
+          if (cell != nullptr) {
+            cell->accept(*this);
+          }
+        }
+      }
+
+      virtual void visitListView(ListView& widget) override {
+        // the widgets of the rows that are not visible are not focusable
+        visitListViewRows(widget);
+
+        if (hidden_search) {
+          Widget *row = widget.getHiddenFocusedRow();
+
+          if (row != nullptr) {
+            row->accept(*this);
+          }
+        }
+      }
+
+      virtual void visitScrollArea(ScrollArea& widget) override {
+        if (!hidden_search) {
+          // only the visible part of the content is focusable
+          visitScrollAreaChild(widget);
+          return;
+        }
+
+        if (widget.hasChild()) {
+          sf::Vector2f saved_translation = hidden_translation;
+          hidden_translation += widget.getOffset();
+          widget.getChild()->accept(*this);
+          hidden_translation = saved_translation;
+        }
+      }
+
       virtual void visitSelect(Select& widget) override {
         visitLeaf(widget);
       }
@@ -91,182 +162,553 @@ namespace ui {
       }
 
       void visitLeaf(Leaf& widget) {
+        if (hidden_search) {
+          // the focused leaf is not visible, it is not in the list
+          if (widget.isFocused()) {
+            focused = &widget;
+            focused_translation = hidden_translation;
+          }
+
+          return;
+        }
+
         if (widget.isFocusable()) {
           focusable.push_back(&widget);
+          translations.push_back(getTranslation());
         }
 
         if (widget.isFocused()) {
           assert(focused == nullptr);
           focused = &widget;
+          focused_translation = getTranslation();
+
+          if (widget.isFocusable()) {
+            focused_index = focusable.size() - 1;
+          }
         }
       }
 
+      std::vector<Leaf*>& focusable;
+      std::vector<sf::Vector2f>& translations;
+      Leaf *focused = nullptr;
+      sf::Vector2f focused_translation;
+      std::size_t focused_index = Area::NoIndex;
 
-      bool isFirstTime() {
-        if (focused == nullptr) {
-          if (!focusable.empty()) {
-            focused = focusable.front();
-            focused->setFocused(true);
-          }
+      bool hidden_search = false;
+      sf::Vector2f hidden_translation;
+    };
 
-          return true;
-        }
+    class LeafList : public WidgetVisitor {
+    public:
+      LeafList(LeafIndex& index, std::vector<Widget*>& list_scrolling)
+      : leaves(index)
+      , scrolling(list_scrolling)
+      {
+      }
 
-        return false;
+      virtual void visitArea(Area& widget) override {
+        visitStackTopChild(widget);
       }
 
-      template<typename Pred>
-      void changeFocusable(Pred pred) {
-        assert(focused != nullptr && !focusable.empty());
+      virtual void visitStack(Stack& widget) override {
+        visitStackTopChild(widget);
+      }
 
-        Leaf *next = nullptr;
+      virtual void visitBin(Bin& widget) override {
+        visitBinChild(widget);
+      }
 
-        float next_distance = 0.0f;
+      virtual void visitForm(Form& widget) override {
+        visitContainerChildren(widget);
+      }
 
-        for (auto leaf : focusable) {
-          if (pred(leaf)) {
-            if (next == nullptr) {
-              next = leaf;
-              next_distance = squared_distance(leaf, focused);
-            } else {
-              float distance = squared_distance(leaf, focused);
+      virtual void visitHBox(HBox& widget) override {
+        visitContainerChildren(widget);
+      }
 
-              if (distance < next_distance) {
-                next = leaf;
-                next_distance = distance;
-              }
-            }
-          }
-        }
+      virtual void visitVBox(VBox& widget) override {
+        visitContainerChildren(widget);
+      }
 
-        if (next == nullptr) {
-          return;
-        }
+      virtual void visitTable(Table& widget) override {
+        visitContainerChildren(widget);
+      }
 
-        focused->setFocused(false);
-        focused = next;
-        focused->setFocused(true);
+      virtual void visitButton(Button& widget) override {
+        leaves.addLeaf(&widget);
       }
 
+      virtual void visitLabel(Label& widget) override {
+        leaves.addLeaf(&widget);
+      }
 
-      void onUp() {
-        changeFocusable(
-          [this](Leaf *widget) {
-            return widget->getCenter().y < focused->getCenter().y && isUpOrDown(focused->getCenter(), widget->getCenter());
-          }
-        );
+      virtual void visitGridView(GridView& widget) override {
+        // the cells move when scrolling, the grid view handles the clicks
+        scrolling.push_back(&widget);
       }
 
-      void onDown() {
-        changeFocusable(
-          [this](Leaf *widget) {
-            return widget->getCenter().y > focused->getCenter().y && isUpOrDown(focused->getCenter(), widget->getCenter());
-          }
-        );
+      virtual void visitListView(ListView& widget) override {
+        // the rows move when scrolling, the list view handles the clicks
+        scrolling.push_back(&widget);
       }
 
-      void onLeft() {
-        changeFocusable(
-          [this](Leaf *widget) {
-            return widget->getCenter().x < focused->getCenter().x && isLeftOrRight(focused->getCenter(), widget->getCenter());
-          }
-        );
+      virtual void visitScrollArea(ScrollArea& widget) override {
+        // the content moves when scrolling, the scroll area handles the clicks
+        scrolling.push_back(&widget);
       }
 
-      void onRight() {
-        changeFocusable(
-          [this](Leaf *widget) {
-            return widget->getCenter().x > focused->getCenter().x && isLeftOrRight(focused->getCenter(), widget->getCenter());
-          }
-        );
+      virtual void visitSelect(Select& widget) override {
+        leaves.addLeaf(&widget);
       }
 
-      std::vector<Leaf*> focusable;
-      Leaf *focused = nullptr;
-    };
+      virtual void visitToggle(Toggle& widget) override {
+        leaves.addLeaf(&widget);
+      }
 
+      LeafIndex& leaves;
+      std::vector<Widget*>& scrolling;
+    };
 
   }
 
+  constexpr std::size_t Area::NoIndex;
+
   Area::Area(const sf::FloatRect& rectangle)
+  : m_layout_count(0)
+  , m_focused(nullptr)
+  , m_focused_translation(0.0f, 0.0f)
+  , m_focused_index(NoIndex)
+  , m_focus_needed(true)
+  , m_navigation_needed(true)
+  , m_leaf_index_enabled(false)
+  , m_leaf_index_needed(true)
   {
     setGeometry(rectangle);
   }
 
   Area::Area(float width, float height)
+  : m_layout_count(0)
+  , m_focused(nullptr)
+  , m_focused_translation(0.0f, 0.0f)
+  , m_focused_index(NoIndex)
+  , m_focus_needed(true)
+  , m_navigation_needed(true)
+  , m_leaf_index_enabled(false)
+  , m_leaf_index_needed(true)
   {
     setGeometry({ 0, 0, width, height});
   }
 
-  void Area::onUp() {
-    FocusableList list;
-    list.visitArea(*this);
+  void Area::invalidateFocus() {
+    m_focus_needed = true;
+  }
 
-    if (list.isFirstTime()) {
+  static constexpr std::size_t MaximumDamage = 8;
+
+  static sf::FloatRect unite(const sf::FloatRect& lhs, const sf::FloatRect& rhs) {
+    float left = std::min(lhs.left, rhs.left);
+    float top = std::min(lhs.top, rhs.top);
+    float right = std::max(lhs.left + lhs.width, rhs.left + rhs.width);
+    float bottom = std::max(lhs.top + lhs.height, rhs.top + rhs.height);
+    return sf::FloatRect(left, top, right - left, bottom - top);
+  }
+
+  void Area::addDamage(const sf::FloatRect& rectangle) {
+    sf::FloatRect damage;
+
+    // the damage outside the area is not visible
+    if (!rectangle.intersects(getGeometry(), damage)) {
       return;
     }
 
-    list.onUp();
+    // merge the rectangles that overlap the new one, and check again with
+    // the merged rectangle
+    std::size_t i = 0;
+
+    while (i < m_damage.size()) {
+      if (m_damage[i].intersects(damage)) {
+        damage = unite(damage, m_damage[i]);
+        m_damage[i] = m_damage.back();
+        m_damage.pop_back();
+        i = 0;
+      } else {
+        ++i;
+      }
+    }
+
+    if (m_damage.size() == MaximumDamage) {
+      for (auto& rect : m_damage) {
+        damage = unite(damage, rect);
+      }
+
+      m_damage.clear();
+    }
+
+    m_damage.push_back(damage);
+  }
+
+  void Area::onUp() {
+    navigate(UP);
   }
 
   void Area::onDown() {
-    FocusableList list;
-    list.visitArea(*this);
+    navigate(DOWN);
+  }
 
-    if (list.isFirstTime()) {
+  void Area::onLeft() {
+    navigate(LEFT);
+  }
+
+  void Area::onRight() {
+    navigate(RIGHT);
+  }
+
+  void Area::onPrimaryAction() {
+    updateFocus();
+
+    if (m_focused != nullptr) {
+      m_focused->onPrimaryAction();
+    }
+  }
+
+  void Area::onSecondaryAction() {
+    updateFocus();
+
+    if (m_focused != nullptr) {
+      m_focused->onSecondaryAction();
+    }
+  }
+
+  void Area::onClick(sf::Mouse::Button button, const sf::Vector2f& mouse) {
+    bool layout_done = !isLayoutRequestNeeded() && !isLayoutAllocationNeeded();
+
+    if (!m_leaf_index_enabled || !layout_done) {
+      Stack::onClick(button, mouse);
       return;
     }
 
-    list.onDown();
+    updateLeafIndex();
+
+    for (auto widget : m_scrolling) {
+      if (widget->getGeometry().contains(mouse)) {
+        widget->onClick(button, mouse);
+        return;
+      }
+    }
+
+    Leaf *leaf = m_leaf_index.find(mouse);
+
+    if (leaf != nullptr) {
+      leaf->onClick(button, mouse);
+    }
   }
 
-  void Area::onLeft() {
-    FocusableList list;
-    list.visitArea(*this);
+  void Area::setLeafIndexEnabled(bool enabled) {
+    m_leaf_index_enabled = enabled;
+    m_leaf_index_needed = true;
 
-    if (list.isFirstTime()) {
+    if (!enabled) {
+      m_leaf_index.clear();
+      m_scrolling.clear();
+    }
+  }
+
+  Leaf *Area::findLeaf(const sf::Vector2f& point) {
+    assert(m_leaf_index_enabled);
+    updateLeafIndex();
+    return m_leaf_index.find(point);
+  }
+
+  void Area::updateLeafIndex() {
+    if (!m_leaf_index_needed) {
       return;
     }
 
-    list.onLeft();
+    m_leaf_index.clear();
+    m_scrolling.clear();
+
+    LeafList list(m_leaf_index, m_scrolling);
+    list.visitArea(*this);
+
+    m_leaf_index.build(getGeometry());
+    m_leaf_index_needed = false;
   }
 
-  void Area::onRight() {
-    FocusableList list;
+  void Area::updateFocus() {
+    if (!m_focus_needed) {
+      return;
+    }
+
+    m_focusable.clear(); // keep the capacity
+    m_translations.clear();
+
+    FocusableList list(m_focusable, m_translations);
     list.visitArea(*this);
 
-    if (list.isFirstTime()) {
+    if (list.focused == nullptr && list.getCulledCount() > 0) {
+      // the focused leaf may be scrolled out of its scroll area
+      list.hidden_search = true;
+      list.visitArea(*this);
+    }
+
+    m_focused = list.focused;
+    m_focused_translation = list.focused_translation;
+    m_focused_index = list.focused_index;
+    m_focus_needed = false;
+    m_navigation_needed = true;
+  }
+
+  void Area::navigate(std::size_t direction) {
+    updateFocus();
+
+    if (m_focused == nullptr) {
+      // first time
+      if (!m_focusable.empty()) {
+        changeFocus(0);
+      }
+
+      return;
+    }
+
+    updateNavigation();
+
+    std::size_t next = NoIndex;
+
+    if (m_focused_index != NoIndex) {
+      next = m_navigation[m_focused_index].next[direction];
+    } else {
+      // the focused widget is not focusable so it is not in the graph
+      next = findNeighbour(m_focused->getCenter() - m_focused_translation, direction);
+    }
+
+    if (next == NoIndex) {
       return;
     }
 
-    list.onRight();
+    changeFocus(next);
   }
 
-  void Area::onPrimaryAction() {
-    FocusableList list;
-    list.visitArea(*this);
+  void Area::changeFocus(std::size_t index) {
+    assert(index < m_focusable.size());
 
-    if (list.focused != nullptr) {
-      list.focused->onPrimaryAction();
+    if (m_focused != nullptr) {
+      m_focused->setFocused(false);
     }
+
+    m_focused = m_focusable[index];
+    m_focused_translation = m_translations[index];
+    m_focused_index = index;
+    m_focused->setFocused(true);
+
+    // the focusable list is still valid
+    m_focus_needed = false;
   }
 
-  void Area::onSecondaryAction() {
-    FocusableList list;
-    list.visitArea(*this);
+  std::size_t Area::findNeighbour(const sf::Vector2f& center, std::size_t direction) const {
+    std::size_t next = NoIndex;
+    float next_distance = 0.0f;
+
+    for (std::size_t i = 0; i < m_navigation.size(); ++i) {
+      const sf::Vector2f& other = m_navigation[i].center;
+
+      if (!isInDirection(direction, center, other)) {
+        continue;
+      }
+
+      float distance = squared_distance(center, other);
+
+      if (next == NoIndex || distance < next_distance) {
+        next = i;
+        next_distance = distance;
+      }
+    }
+
+    return next;
+  }
+
+  void Area::updateNavigation() {
+    updateFocus();
+
+    if (!m_navigation_needed) {
+      return;
+    }
+
+    // compute the whole graph
+    std::size_t count = m_focusable.size();
+    m_navigation.resize(count);
+
+    for (std::size_t i = 0; i < count; ++i) {
+      m_navigation[i].center = m_focusable[i]->getCenter() - m_translations[i];
+    }
+
+    // the widgets sorted by position, so that the search of a neighbour
+    // only looks at the widgets that are close enough in the direction
+    m_sorted_x.resize(count);
+    std::iota(m_sorted_x.begin(), m_sorted_x.end(), 0);
+    std::stable_sort(m_sorted_x.begin(), m_sorted_x.end(), [this](std::size_t lhs, std::size_t rhs) {
+      return m_navigation[lhs].center.x < m_navigation[rhs].center.x;
+    });
+
+    m_sorted_y.resize(count);
+    std::iota(m_sorted_y.begin(), m_sorted_y.end(), 0);
+    std::stable_sort(m_sorted_y.begin(), m_sorted_y.end(), [this](std::size_t lhs, std::size_t rhs) {
+      return m_navigation[lhs].center.y < m_navigation[rhs].center.y;
+    });
+
+    for (std::size_t i = 0; i < count; ++i) {
+      for (std::size_t direction = 0; direction < 4; ++direction) {
+        m_navigation[i].next[direction] = findSortedNeighbour(i, direction);
+      }
+    }
+
+    m_navigation_needed = false;
+  }
+
+  std::size_t Area::findSortedNeighbour(std::size_t index, std::size_t direction) const {
+    const sf::Vector2f& center = m_navigation[index].center;
+    bool vertical = (direction == UP || direction == DOWN);
+    const std::vector<std::size_t>& sorted = vertical ? m_sorted_y : m_sorted_x;
+
+    auto coordinate = [this, vertical](std::size_t i) {
+      return vertical ? m_navigation[i].center.y : m_navigation[i].center.x;
+    };
+
+    float position = coordinate(index);
+    std::size_t next = NoIndex;
+    float next_distance = 0.0f;
+
+    // same result as findNeighbour(): the distance is at least the distance
+    // along the direction, so the search stops at the first widget that is
+    // farther than the best one along the direction
+    auto check = [&](std::size_t i) {
+      float delta = coordinate(i) - position;
+
+      if (next != NoIndex && delta * delta > next_distance) {
+        return false;
+      }
+
+      const sf::Vector2f& other = m_navigation[i].center;
+
+      if (isInDirection(direction, center, other)) {
+        float distance = squared_distance(center, other);
+
+        if (next == NoIndex || distance < next_distance || (distance == next_distance && i < next)) {
+          next = i;
+          next_distance = distance;
+        }
+      }
+
+      return true;
+    };
+
+    if (direction == DOWN || direction == RIGHT) {
+      auto it = std::upper_bound(sorted.begin(), sorted.end(), position, [&coordinate](float value, std::size_t i) {
+        return value < coordinate(i);
+      });
+
+      for (; it != sorted.end(); ++it) {
+        if (!check(*it)) {
+          break;
+        }
+      }
+    } else {
+      auto it = std::lower_bound(sorted.begin(), sorted.end(), position, [&coordinate](std::size_t i, float value) {
+        return coordinate(i) < value;
+      });
+
+      while (it != sorted.begin()) {
+        --it;
+
+        if (!check(*it)) {
+          break;
+        }
+      }
+    }
+
+    return next;
+  }
 
-    if (list.focused != nullptr) {
-      list.focused->onSecondaryAction();
+  void Area::updateMovedNavigation() {
+    if (m_focus_needed || m_navigation_needed) {
+      // the whole graph is computed at the next navigation
+      return;
+    }
+
+    std::size_t count = m_focusable.size();
+    assert(m_navigation.size() == count);
+
+    /*
+     * only take into account the widgets that have moved since the last time:
+     * - a widget that has moved computes its neighbours again
+     * - a widget whose neighbour has moved computes this neighbour again
+     * - any other widget checks if a widget that has moved is a better neighbour
+     */
+
+    // the scratch vectors keep their capacity
+    std::vector<std::size_t>& moved = m_moved;
+    std::vector<bool>& has_moved = m_has_moved;
+    moved.clear();
+    has_moved.assign(count, false);
+
+    for (std::size_t i = 0; i < count; ++i) {
+      sf::Vector2f center = m_focusable[i]->getCenter() - m_translations[i];
+
+      if (center != m_navigation[i].center) {
+        m_navigation[i].center = center;
+        moved.push_back(i);
+        has_moved[i] = true;
+      }
+    }
+
+    if (moved.empty()) {
+      return;
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+      auto& node = m_navigation[i];
+
+      for (std::size_t direction = 0; direction < 4; ++direction) {
+        std::size_t next = node.next[direction];
+
+        if (has_moved[i] || (next != NoIndex && has_moved[next])) {
+          node.next[direction] = findNeighbour(node.center, direction);
+          continue;
+        }
+
+        float next_distance = (next == NoIndex) ? 0.0f : squared_distance(node.center, m_navigation[next].center);
+
+        for (auto other : moved) {
+          const sf::Vector2f& other_center = m_navigation[other].center;
+
+          if (!isInDirection(direction, node.center, other_center)) {
+            continue;
+          }
+
+          float distance = squared_distance(node.center, other_center);
+
+          // keep the first one in case of equality, like findNeighbour()
+          if (next == NoIndex || distance < next_distance || (distance == next_distance && other < next)) {
+            next = other;
+            next_distance = distance;
+          }
+        }
+
+        node.next[direction] = next;
+      }
     }
   }
 
 
   void Area::updateLayout() {
+    m_layout_count = 0;
+
     if (!hasChildren()) {
       return;
     }
 
-    getTopChild()->layoutRequest();
+    std::size_t layout_count = getLayoutAllocationCount();
+
+    updateLayoutRequest();
 
     auto self_geometry = getGeometry();
     auto child_hint = getTopChild()->getSizeHint();
@@ -278,10 +720,20 @@ namespace ui {
       return;
     }
 
-    computeGeometry(getVerticalGeometry(), getTopChild()->getVerticalGeometry());
-    computeGeometry(getHorizontalGeometry(), getTopChild()->getHorizontalGeometry());
+    updateLayoutAllocation();
+
+    m_layout_count = getLayoutAllocationCount() - layout_count;
+
+    if (m_layout_count > 0) {
+      // the centers of the focusable widgets may have changed
+      updateMovedNavigation();
 
-    getTopChild()->layoutAllocation();
+      m_leaf_index_needed = true;
+
+      if (m_leaf_index_enabled) {
+        updateLeafIndex();
+      }
+    }
   }
 
   void Area::accept(WidgetVisitor& visitor) {
@@ -44,7 +44,7 @@ namespace ui {
       return;
     }
 
-    getChild()->layoutRequest();
+    getChild()->updateLayoutRequest();
 
     getVerticalGeometry().hint = getChild()->getVerticalGeometry().hint;
     getHorizontalGeometry().hint = getChild()->getHorizontalGeometry().hint;
@@ -58,7 +58,7 @@ namespace ui {
     computeGeometry(getVerticalGeometry(), getChild()->getVerticalGeometry());
     computeGeometry(getHorizontalGeometry(), getChild()->getHorizontalGeometry());
 
-    getChild()->layoutAllocation();
+    getChild()->updateLayoutAllocation();
   }
 
   void Bin::accept(WidgetVisitor& visitor) {
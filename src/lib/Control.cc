@@ -16,18 +16,87 @@
 #include <ui/Control.h>
 
 #include <cassert>
+#include <set>
+#include <tuple>
 
 namespace ui {
 
+  // event source
+
+  EventSource EventSource::fromEvent(const sf::Event& event) {
+    EventSource source;
+
+    switch (event.type) {
+      case sf::Event::KeyPressed:
+      case sf::Event::KeyReleased:
+        source.type = Type::KEY;
+        source.code = event.key.code;
+        break;
+      case sf::Event::MouseButtonPressed:
+      case sf::Event::MouseButtonReleased:
+        source.type = Type::MOUSE_BUTTON;
+        source.code = event.mouseButton.button;
+        break;
+      case sf::Event::JoystickButtonPressed:
+      case sf::Event::JoystickButtonReleased:
+        source.type = Type::GAMEPAD_BUTTON;
+        source.id = event.joystickButton.joystickId;
+        source.code = event.joystickButton.button;
+        break;
+      case sf::Event::JoystickMoved:
+        source.type = Type::GAMEPAD_AXIS;
+        source.id = event.joystickMove.joystickId;
+        source.code = event.joystickMove.axis;
+        break;
+      case sf::Event::Closed:
+        source.type = Type::CLOSE;
+        break;
+      default:
+        break;
+    }
+
+    return source;
+  }
+
+  bool operator<(const EventSource& lhs, const EventSource& rhs) {
+    return std::tie(lhs.type, lhs.id, lhs.code) < std::tie(rhs.type, rhs.id, rhs.code);
+  }
+
+
   // control
 
+  static const char *internName(const std::string& name) {
+    // the elements of a set do not move, so the pointers stay valid
+    static std::set<std::string> names;
+    return names.insert(name).first->c_str();
+  }
+
+  Control::Control(const std::string& name, const std::string& controller_name)
+  : m_name(internName(name))
+  , m_controller_name(internName(controller_name))
+  , m_active(false)
+  {
+  }
+
   Control::~Control() {
   }
 
+  EventSource Control::getEventSource() const {
+    return EventSource();
+  }
+
 
   // gamepad axis control
 
   static const char *axisName(sf::Joystick::Axis axis) {
+    static const char *names[] = { "X", "Y", "Z", "R", "U", "V", "PovX", "PovY" };
+
+    std::size_t index = static_cast<std::size_t>(axis);
+
+    if (index < sizeof names / sizeof names[0]) {
+      return names[index];
+    }
+
     return "?";
   }
 
@@ -52,11 +121,34 @@ namespace ui {
     }
   }
 
+  EventSource GamepadAxisControl::getEventSource() const {
+    EventSource source;
+    source.type = EventSource::Type::GAMEPAD_AXIS;
+    source.id = m_id;
+    source.code = m_axis;
+    return source;
+  }
+
 
   // gamepad button control
 
+  static const char *gamepadButtonName(unsigned int button) {
+    static const char *names[] = {
+      "0",  "1",  "2",  "3",  "4",  "5",  "6",  "7",
+      "8",  "9",  "10", "11", "12", "13", "14", "15",
+      "16", "17", "18", "19", "20", "21", "22", "23",
+      "24", "25", "26", "27", "28", "29", "30", "31",
+    };
+
+    if (button < sizeof names / sizeof names[0]) {
+      return names[button];
+    }
+
+    return "?";
+  }
+
   GamepadButtonControl::GamepadButtonControl(unsigned int id, unsigned int button)
-  : Control("gamepad (button)", std::to_string(button))
+  : Control("gamepad (button)", gamepadButtonName(button))
   , m_id(id)
   , m_button(button)
   {
@@ -76,6 +168,14 @@ namespace ui {
     }
   }
 
+  EventSource GamepadButtonControl::getEventSource() const {
+    EventSource source;
+    source.type = EventSource::Type::GAMEPAD_BUTTON;
+    source.id = m_id;
+    source.code = m_button;
+    return source;
+  }
+
 
   // key control
 
@@ -104,10 +204,25 @@ namespace ui {
     }
   }
 
+  EventSource KeyControl::getEventSource() const {
+    EventSource source;
+    source.type = EventSource::Type::KEY;
+    source.code = m_key;
+    return source;
+  }
+
 
   // mouse button control
 
-  const char *buttonName(sf::Mouse::Button button) {
+  static const char *buttonName(sf::Mouse::Button button) {
+    static const char *names[] = { "Left", "Right", "Middle", "XButton1", "XButton2" };
+
+    std::size_t index = static_cast<std::size_t>(button);
+
+    if (index < sizeof names / sizeof names[0]) {
+      return names[index];
+    }
+
     return "?";
   }
 
@@ -131,6 +246,13 @@ namespace ui {
     }
   }
 
+  EventSource MouseButtonControl::getEventSource() const {
+    EventSource source;
+    source.type = EventSource::Type::MOUSE_BUTTON;
+    source.code = m_button;
+    return source;
+  }
+
 
   // close control
 
@@ -145,4 +267,10 @@ namespace ui {
     }
   }
 
+  EventSource CloseControl::getEventSource() const {
+    EventSource source;
+    source.type = EventSource::Type::CLOSE;
+    return source;
+  }
+
 }
@@ -15,86 +15,224 @@
  */
 #include <ui/DebugVisitor.h>
 
+#include <algorithm>
+
 namespace ui {
 
   void DebugVisitor::visitArea(Area& widget) {
+    enter();
     visitStackTopChild(widget);
     drawWidget(widget);
+    leave();
   }
 
   void DebugVisitor::visitBin(Bin& widget)  {
+    enter();
     visitBinChild(widget);
+    leave();
   }
 
   void DebugVisitor::visitButton(Button& widget)  {
+    enter();
     drawLeaf(widget);
+    leave();
   }
 
   void DebugVisitor::visitForm(Form& widget) {
+    enter();
     visitContainerChildren(widget);
     drawWidget(widget);
+    leave();
+  }
+
+  void DebugVisitor::visitGridView(GridView& widget) {
+    enter();
+    beginClip(widget);
+    visitGridViewCells(widget);
+    endClip();
+    drawWidget(widget);
+    leave();
   }
 
   void DebugVisitor::visitHBox(HBox& widget)  {
+    enter();
     visitContainerChildren(widget);
     drawWidget(widget);
+    leave();
   }
 
   void DebugVisitor::visitLabel(Label& widget)  {
+    enter();
     drawLeaf(widget);
+    leave();
+  }
+
+  void DebugVisitor::visitListView(ListView& widget)  {
+    enter();
+    beginClip(widget);
+    visitListViewRows(widget);
+    endClip();
+    drawWidget(widget);
+    leave();
+  }
+
+  void DebugVisitor::visitScrollArea(ScrollArea& widget)  {
+    enter();
+    beginClip(widget);
+    visitScrollAreaChild(widget);
+    endClip();
+    drawWidget(widget);
+    leave();
   }
 
   void DebugVisitor::visitSelect(Select& widget)  {
+    enter();
     drawLeaf(widget);
+    leave();
   }
 
   void DebugVisitor::visitStack(Stack& widget)  {
+    enter();
     visitStackTopChild(widget);
     drawWidget(widget);
+    leave();
   }
 
   void DebugVisitor::visitTable(Table& widget) {
+    enter();
     visitContainerChildren(widget);
     drawWidget(widget);
+    leave();
   }
 
   void DebugVisitor::visitToggle(Toggle& widget)  {
+    enter();
     drawLeaf(widget);
+    leave();
   }
 
   void DebugVisitor::visitVBox(VBox& widget)  {
+    enter();
     visitContainerChildren(widget);
     drawWidget(widget);
+    leave();
   }
 
   void DebugVisitor::drawLeaf(Leaf& widget) {
-    sf::RectangleShape rectangle;
-    rectangle.setFillColor(sf::Color::Transparent);
-    rectangle.setOutlineThickness(1);
+    addOutline(widget.getGeometry(), m_depth_coloring ? getDepthColor() : sf::Color::Red);
+    addOutline(widget.getInternalGeometry(), sf::Color::Green);
+  }
 
-    sf::FloatRect widget_geometry = widget.getGeometry();
-    rectangle.setSize({ widget_geometry.width, widget_geometry.height });
-    rectangle.setPosition(widget_geometry.left, widget_geometry.top);
-    rectangle.setOutlineColor(sf::Color::Red);
-    m_target.draw(rectangle);
+  void DebugVisitor::drawWidget(Widget& widget) {
+    addOutline(widget.getGeometry(), m_depth_coloring ? getDepthColor() : sf::Color::Blue);
+  }
 
-    sf::FloatRect internal_geometry = widget.getInternalGeometry();
-    rectangle.setSize({ internal_geometry.width, internal_geometry.height });
-    rectangle.setPosition(internal_geometry.left, internal_geometry.top);
-    rectangle.setOutlineColor(sf::Color::Green);
-    m_target.draw(rectangle);
+  void DebugVisitor::enter() {
+    ++m_depth;
   }
 
-  void DebugVisitor::drawWidget(Widget& widget) {
-    sf::RectangleShape rectangle;
-    rectangle.setFillColor(sf::Color::Transparent);
-    rectangle.setOutlineThickness(1);
-
-    sf::FloatRect widget_geometry = widget.getGeometry();
-    rectangle.setSize({ widget_geometry.width, widget_geometry.height });
-    rectangle.setPosition(widget_geometry.left, widget_geometry.top);
-    rectangle.setOutlineColor(sf::Color::Blue);
-    m_target.draw(rectangle);
+  void DebugVisitor::leave() {
+    --m_depth;
+
+    if (m_depth > 0) {
+      return;
+    }
+
+    // the visit of the root is finished, draw everything at once
+    if (m_lines.getVertexCount() > 0) {
+      m_target.draw(m_lines);
+      m_lines.clear();
+    }
+  }
+
+  void DebugVisitor::beginClip(Widget& widget) {
+    // in the coordinates of the target, like the outlines
+    const sf::Vector2f& translation = getTranslation();
+    const sf::FloatRect& geometry = widget.getGeometry();
+    sf::FloatRect clip(geometry.left - translation.x, geometry.top - translation.y, geometry.width, geometry.height);
+
+    if (!m_clips.empty() && !m_clips.back().intersects(clip, clip)) {
+      // nothing is visible
+      clip = sf::FloatRect();
+    }
+
+    m_clips.push_back(clip);
+  }
+
+  void DebugVisitor::endClip() {
+    m_clips.pop_back();
+  }
+
+  void DebugVisitor::addOutline(const sf::FloatRect& geometry, const sf::Color& color) {
+    // same place as the outline of a sf::RectangleShape with a thickness of
+    // 1: the lines go through the center of the pixels around the rectangle
+    const sf::Vector2f& translation = getTranslation();
+    float left = geometry.left - translation.x - 0.5f;
+    float top = geometry.top - translation.y - 0.5f;
+    float right = geometry.left - translation.x + geometry.width + 0.5f;
+    float bottom = geometry.top - translation.y + geometry.height + 0.5f;
+
+    addLine({ left, top }, { right, top }, color);
+    addLine({ right, top }, { right, bottom }, color);
+    addLine({ right, bottom }, { left, bottom }, color);
+    addLine({ left, bottom }, { left, top }, color);
+  }
+
+  void DebugVisitor::addLine(sf::Vector2f start, sf::Vector2f end, const sf::Color& color) {
+    if (!m_clips.empty()) {
+      // the lines are either horizontal or vertical
+      const sf::FloatRect& clip = m_clips.back();
+      float clip_right = clip.left + clip.width;
+      float clip_bottom = clip.top + clip.height;
+
+      if (start.y == end.y) {
+        if (start.y < clip.top || start.y > clip_bottom) {
+          return;
+        }
+
+        float first = std::max(std::min(start.x, end.x), clip.left);
+        float last = std::min(std::max(start.x, end.x), clip_right);
+
+        if (first >= last) {
+          return;
+        }
+
+        start.x = first;
+        end.x = last;
+      } else {
+        if (start.x < clip.left || start.x > clip_right) {
+          return;
+        }
+
+        float first = std::max(std::min(start.y, end.y), clip.top);
+        float last = std::min(std::max(start.y, end.y), clip_bottom);
+
+        if (first >= last) {
+          return;
+        }
+
+        start.y = first;
+        end.y = last;
+      }
+    }
+
+    m_lines.append(sf::Vertex(start, color));
+    m_lines.append(sf::Vertex(end, color));
+  }
+
+  sf::Color DebugVisitor::getDepthColor() const {
+    static const sf::Color Colors[] = {
+      sf::Color::Blue,
+      sf::Color::Red,
+      sf::Color::Magenta,
+      sf::Color::Cyan,
+      sf::Color::Yellow,
+      sf::Color(0xFF, 0x80, 0x00), // orange
+    };
+
+    static constexpr unsigned ColorCount = sizeof(Colors) / sizeof(Colors[0]);
+
+    return Colors[(m_depth - 1) % ColorCount];
   }
 
 }
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2014, Julien Bernard
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#include <ui/EventQueue.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace ui {
+
+  static constexpr std::size_t NoSlot = static_cast<std::size_t>(-1);
+  static constexpr std::size_t NoEntry = static_cast<std::size_t>(-1);
+
+  static std::size_t slotIndex(const sf::Event& event) {
+    switch (event.type) {
+      case sf::Event::MouseMoved:
+        return 0;
+      case sf::Event::JoystickMoved:
+        if (event.joystickMove.joystickId < sf::Joystick::Count) {
+          return 1 + event.joystickMove.joystickId * sf::Joystick::AxisCount + event.joystickMove.axis;
+        }
+        break;
+      default:
+        break;
+    }
+
+    return NoSlot;
+  }
+
+  EventQueue::EventQueue()
+  : m_next(0)
+  , m_pushed_count(0)
+  , m_folded_count(0)
+  {
+    std::fill(std::begin(m_slots), std::end(m_slots), NoEntry);
+  }
+
+  void EventQueue::pushEvent(const sf::Event& event) {
+    ++m_pushed_count;
+
+    std::size_t slot = slotIndex(event);
+
+    if (slot != NoSlot) {
+      std::size_t previous = m_slots[slot];
+
+      if (previous != NoEntry && previous >= m_next) {
+        m_entries[previous].folded = true;
+        ++m_folded_count;
+      }
+
+      m_slots[slot] = m_entries.size();
+    }
+
+    m_entries.push_back({ event, false });
+  }
+
+  bool EventQueue::pollEvent(sf::Event& event) {
+    while (m_next < m_entries.size()) {
+      const Entry& entry = m_entries[m_next++];
+
+      if (!entry.folded) {
+        event = entry.event;
+        return true;
+      }
+    }
+
+    clear();
+    return false;
+  }
+
+  void EventQueue::clear() {
+    m_entries.clear(); // keep the capacity
+    m_next = 0;
+    std::fill(std::begin(m_slots), std::end(m_slots), NoEntry);
+  }
+
+}
@@ -0,0 +1,502 @@
+/*
+ * Copyright (c) 2014, Julien Bernard
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#include <ui/GridView.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include <ui/WidgetVisitor.h>
+
+namespace ui {
+
+  GridModel::~GridModel() {
+  }
+
+  constexpr std::size_t GridView::DefaultSampleCount;
+  constexpr std::size_t GridView::NoRow;
+
+  GridView::GridView(GridModel& model, float row_height)
+  : m_model(model)
+  , m_row_height(row_height)
+  , m_sample_count(DefaultSampleCount)
+  , m_column_starts(1, 0.0f)
+  , m_offset(0.0f, 0.0f)
+  , m_first_row(0)
+  , m_first_column(0)
+  , m_row_count(0)
+  , m_column_count(0)
+  , m_focused_row(NoRow)
+  , m_focused_column(0)
+  , m_focused_widget(nullptr)
+  , m_measure_needed(true)
+  , m_bind_needed(true)
+  , m_reveal_needed(false)
+  {
+    setSizePolicy(SizePolicy::MINIMUM, SizePolicy::MINIMUM);
+  }
+
+  GridView::~GridView() {
+    delete getHiddenFocusedCell();
+
+    for (auto cell : m_cells) {
+      delete cell;
+    }
+
+    for (auto cell : m_spare_cells) {
+      delete cell;
+    }
+  }
+
+  void GridView::setRowHeight(float row_height) {
+    m_row_height = row_height;
+    invalidateLayout();
+  }
+
+  void GridView::setSampleCount(std::size_t count) {
+    m_sample_count = std::max(count, static_cast<std::size_t>(1));
+    m_measure_needed = true;
+    invalidateLayout();
+  }
+
+  sf::Vector2f GridView::getContentSize() const {
+    return { m_column_starts.back(), m_model.getRowCount() * m_row_height };
+  }
+
+  void GridView::invalidateCells() {
+    m_measure_needed = true;
+    m_bind_needed = true;
+
+    // the number of rows and columns may have changed
+    invalidateLayout();
+    invalidateRendering();
+    invalidateFocus();
+  }
+
+  void GridView::setOffset(const sf::Vector2f& offset) {
+    sf::Vector2f clamped = clampOffset(offset);
+
+    if (clamped == m_offset) {
+      return;
+    }
+
+    // the layout of the grid view does not change, only the cells move
+    m_offset = clamped;
+    updateCells();
+
+    invalidateRendering();
+    invalidateFocus();
+  }
+
+  void GridView::scrollToCell(std::size_t row, std::size_t column) {
+    if (column + 1 >= m_column_starts.size()) {
+      return;
+    }
+
+    sf::FloatRect geometry = getGeometry();
+    sf::FloatRect cell(m_column_starts[column], row * m_row_height, getColumnWidth(column), m_row_height);
+    sf::Vector2f offset = m_offset;
+
+    if (cell.left + cell.width > offset.x + geometry.width) {
+      offset.x = cell.left + cell.width - geometry.width;
+    }
+
+    if (cell.left < offset.x) {
+      offset.x = cell.left;
+    }
+
+    if (cell.top + cell.height > offset.y + geometry.height) {
+      offset.y = cell.top + cell.height - geometry.height;
+    }
+
+    if (cell.top < offset.y) {
+      offset.y = cell.top;
+    }
+
+    setOffset(offset);
+  }
+
+  Widget *GridView::getHiddenFocusedCell() const {
+    if (m_focused_widget == nullptr || isVisibleCell(m_focused_row, m_focused_column)) {
+      return nullptr;
+    }
+
+    return m_focused_widget;
+  }
+
+  void GridView::onClick(sf::Mouse::Button button, const sf::Vector2f& mouse) {
+    sf::FloatRect geometry = getGeometry();
+
+    if (!geometry.contains(mouse) || m_row_height <= 0.0f) {
+      return;
+    }
+
+    // the cells are aligned in rows and columns, no need to look at each of
+    // them
+    std::size_t row = static_cast<std::size_t>((mouse.y - geometry.top + m_offset.y) / m_row_height);
+    std::size_t column = findColumn(mouse.x - geometry.left + m_offset.x);
+
+    if (row < m_first_row || row >= m_first_row + m_row_count) {
+      return;
+    }
+
+    if (column < m_first_column || column >= m_first_column + m_column_count) {
+      return;
+    }
+
+    Widget *cell = m_cells[(row - m_first_row) * m_column_count + (column - m_first_column)];
+
+    if (cell->getGeometry().contains(mouse)) {
+      cell->onClick(button, mouse);
+    }
+  }
+
+  void GridView::layoutRequest() {
+    // the size hint of the cells is not used: it is the purpose of a grid
+    // view to be smaller than its cells
+  }
+
+  void GridView::layoutAllocation() {
+    if (m_measure_needed) {
+      measureColumns();
+    }
+
+    sf::Vector2f offset = clampOffset(m_offset);
+
+    if (m_reveal_needed && m_focused_row != NoRow) {
+      offset = clampOffset(revealOffset(m_focused_row, m_focused_column));
+    }
+
+    m_reveal_needed = false;
+
+    if (offset != m_offset) {
+      m_offset = offset;
+      invalidateRendering();
+      invalidateFocus();
+    }
+
+    // the number of visible cells depends on the size of the grid view
+    updateCells();
+  }
+
+  void GridView::addDamage(const sf::FloatRect& rectangle) {
+    sf::FloatRect damage;
+
+    // the part of the cells outside the grid view is not visible
+    if (!rectangle.intersects(getGeometry(), damage)) {
+      return;
+    }
+
+    Widget *parent = getParent();
+
+    if (parent != nullptr) {
+      parent->addDamage(damage);
+    }
+  }
+
+  void GridView::childFocusChanged(Widget& child, Leaf& leaf, bool focused) {
+    std::size_t row = NoRow;
+    std::size_t column = 0;
+
+    if (&child == m_focused_widget) {
+      row = m_focused_row;
+      column = m_focused_column;
+    } else {
+      auto it = std::find(m_cells.begin(), m_cells.end(), &child);
+
+      if (it != m_cells.end()) {
+        std::size_t i = it - m_cells.begin();
+        row = m_first_row + i / m_column_count;
+        column = m_first_column + i % m_column_count;
+      }
+    }
+
+    if (row != NoRow) {
+      if (focused) {
+        m_focused_row = row;
+        m_focused_column = column;
+        m_focused_widget = &child;
+
+        // the focus only moves to the visible cells, so the next cells are
+        // shown when the focus reaches a cell on the border, unless there is
+        // no cell beyond this border
+        bool top_edge = row <= m_first_row && row > 0;
+        bool bottom_edge = row + 1 >= m_first_row + m_row_count && row + 1 < m_model.getRowCount();
+        bool left_edge = column <= m_first_column && column > 0;
+        bool right_edge = column + 1 >= m_first_column + m_column_count && column + 1 < m_model.getColumnCount();
+
+        if (top_edge || bottom_edge || left_edge || right_edge) {
+          m_reveal_needed = true;
+          invalidateLayout();
+        }
+      } else if (row == m_focused_row && column == m_focused_column) {
+        Widget *hidden = getHiddenFocusedCell();
+
+        if (hidden != nullptr) {
+          m_spare_cells.push_back(hidden);
+        }
+
+        m_focused_row = NoRow;
+        m_focused_widget = nullptr;
+      }
+    }
+
+    Widget::childFocusChanged(child, leaf, focused);
+  }
+
+  void GridView::accept(WidgetVisitor& visitor) {
+    visitor.visitGridView(*this);
+  }
+
+  sf::Vector2f GridView::clampOffset(const sf::Vector2f& offset) const {
+    sf::FloatRect geometry = getGeometry();
+    sf::Vector2f content = getContentSize();
+
+    float max_x = std::max(content.x - geometry.width, 0.0f);
+    float max_y = std::max(content.y - geometry.height, 0.0f);
+
+    return { std::min(std::max(offset.x, 0.0f), max_x), std::min(std::max(offset.y, 0.0f), max_y) };
+  }
+
+  sf::Vector2f GridView::revealOffset(std::size_t row, std::size_t column) const {
+    // the neighbours of the cell are shown if there is enough room
+    sf::FloatRect geometry = getGeometry();
+    std::size_t row_count = m_model.getRowCount();
+    std::size_t column_count = m_column_starts.size() - 1;
+
+    float top = (row > 0 ? row - 1 : row) * m_row_height;
+    float bottom = std::min(row + 2, row_count) * m_row_height;
+
+    if (bottom - top > geometry.height) {
+      top = row * m_row_height;
+      bottom = top + m_row_height;
+    }
+
+    float left = m_column_starts[column > 0 ? column - 1 : column];
+    float right = m_column_starts[std::min(column + 2, column_count)];
+
+    if (right - left > geometry.width) {
+      left = m_column_starts[column];
+      right = m_column_starts[column + 1];
+    }
+
+    sf::Vector2f offset = m_offset;
+
+    if (right > offset.x + geometry.width) {
+      offset.x = right - geometry.width;
+    }
+
+    if (left < offset.x) {
+      offset.x = left;
+    }
+
+    if (bottom > offset.y + geometry.height) {
+      offset.y = bottom - geometry.height;
+    }
+
+    if (top < offset.y) {
+      offset.y = top;
+    }
+
+    return offset;
+  }
+
+  bool GridView::isVisibleCell(std::size_t row, std::size_t column) const {
+    return m_first_row <= row && row < m_first_row + m_row_count
+        && m_first_column <= column && column < m_first_column + m_column_count;
+  }
+
+  std::size_t GridView::findColumn(float position) const {
+    // the last column whose start is before the position
+    auto it = std::upper_bound(m_column_starts.begin(), m_column_starts.end(), position);
+
+    if (it == m_column_starts.begin()) {
+      return 0;
+    }
+
+    std::size_t column = (it - m_column_starts.begin()) - 1;
+    return std::min(column, m_column_starts.size() - 1);
+  }
+
+  void GridView::measureColumns() {
+    std::size_t row_count = m_model.getRowCount();
+    std::size_t column_count = m_model.getColumnCount();
+
+    m_column_starts.assign(column_count + 1, 0.0f);
+    m_measure_needed = false;
+
+    if (row_count == 0 || column_count == 0) {
+      return;
+    }
+
+    // the sampled rows are spread over all the rows
+    std::size_t sample_count = std::min(m_sample_count, row_count);
+    Widget *cell = takeSpareCell();
+
+    for (std::size_t column = 0; column < column_count; ++column) {
+      float width = 0.0f;
+
+      for (std::size_t sample = 0; sample < sample_count; ++sample) {
+        std::size_t row = (sample_count == 1) ? 0 : sample * (row_count - 1) / (sample_count - 1);
+        bindCell(*cell, row, column);
+        cell->updateLayoutRequest();
+        width = std::max(width, cell->getHorizontalGeometry().hint);
+      }
+
+      m_column_starts[column + 1] = m_column_starts[column] + width;
+    }
+
+    m_spare_cells.push_back(cell);
+  }
+
+  void GridView::updateCells() {
+    sf::FloatRect geometry = getGeometry();
+    std::size_t row_count = m_model.getRowCount();
+    std::size_t column_count = m_column_starts.size() - 1;
+
+    std::size_t first_row = 0;
+    std::size_t last_row = 0;
+    std::size_t first_column = 0;
+    std::size_t last_column = 0;
+
+    if (row_count > 0 && column_count > 0 && m_row_height > 0.0f) {
+      first_row = std::min(static_cast<std::size_t>(m_offset.y / m_row_height), row_count);
+      last_row = std::min(static_cast<std::size_t>(std::ceil((m_offset.y + geometry.height) / m_row_height)), row_count);
+
+      // the columns whose start is before the right side of the grid view
+      first_column = findColumn(m_offset.x);
+      auto it = std::lower_bound(m_column_starts.begin(), m_column_starts.end(), m_offset.x + geometry.width);
+      last_column = std::min(static_cast<std::size_t>(it - m_column_starts.begin()), column_count);
+      last_column = std::max(last_column, first_column);
+    }
+
+    std::size_t visible_columns = last_column - first_column;
+
+    if (m_focused_row != NoRow && (m_focused_row >= row_count || m_focused_column >= column_count)) {
+      // the focused cell has been removed
+      m_focused_row = NoRow;
+    }
+
+    // keep the widgets of the cells that are still visible, and recycle the
+    // others, except the widget of the focused cell
+    m_next_cells.assign((last_row - first_row) * visible_columns, nullptr);
+    bool focused_kept = false;
+
+    for (std::size_t i = 0; i < m_cells.size(); ++i) {
+      std::size_t row = m_first_row + i / m_column_count;
+      std::size_t column = m_first_column + i % m_column_count;
+
+      if (!m_bind_needed && first_row <= row && row < last_row && first_column <= column && column < last_column) {
+        m_next_cells[(row - first_row) * visible_columns + (column - first_column)] = m_cells[i];
+        focused_kept = focused_kept || m_cells[i] == m_focused_widget;
+      } else if (m_cells[i] != m_focused_widget) {
+        m_spare_cells.push_back(m_cells[i]);
+      }
+    }
+
+    if (m_focused_widget != nullptr && !focused_kept) {
+      if (m_focused_row == NoRow) {
+        m_spare_cells.push_back(m_focused_widget);
+      } else {
+        if (m_bind_needed) {
+          bindCell(*m_focused_widget, m_focused_row, m_focused_column);
+        }
+
+        if (first_row <= m_focused_row && m_focused_row < last_row && first_column <= m_focused_column && m_focused_column < last_column) {
+          m_next_cells[(m_focused_row - first_row) * visible_columns + (m_focused_column - first_column)] = m_focused_widget;
+        }
+      }
+    }
+
+    if (m_focused_row == NoRow) {
+      m_focused_widget = nullptr;
+    }
+
+    for (std::size_t i = 0; i < m_next_cells.size(); ++i) {
+      if (m_next_cells[i] != nullptr) {
+        continue;
+      }
+
+      Widget *cell = takeSpareCell();
+      bindCell(*cell, first_row + i / visible_columns, first_column + i % visible_columns);
+      m_next_cells[i] = cell;
+    }
+
+    m_cells.swap(m_next_cells);
+    m_first_row = first_row;
+    m_first_column = first_column;
+    m_row_count = last_row - first_row;
+    m_column_count = visible_columns;
+    m_bind_needed = false;
+
+    placeCells();
+  }
+
+  void GridView::bindCell(Widget& widget, std::size_t row, std::size_t column) {
+    // the cell is detached while it is updated so that its changes do not
+    // invalidate the whole hierarchy: the grid view takes care of the cell
+    widget.setParent(nullptr);
+    m_model.updateCell(widget, row, column, row == m_focused_row && column == m_focused_column);
+    widget.setParent(this);
+  }
+
+  Widget *GridView::takeSpareCell() {
+    if (m_spare_cells.empty()) {
+      return m_model.createCell();
+    }
+
+    Widget *cell = m_spare_cells.back();
+    m_spare_cells.pop_back();
+    return cell;
+  }
+
+  void GridView::placeCells() {
+    auto it = m_cells.begin();
+
+    for (std::size_t row = m_first_row; row < m_first_row + m_row_count; ++row) {
+      for (std::size_t column = m_first_column; column < m_first_column + m_column_count; ++column) {
+        placeCell(**it++, row, column);
+      }
+    }
+
+    // the hidden focused cell is placed where it would be, so that the focus
+    // can move from it to the visible cells
+    Widget *hidden = getHiddenFocusedCell();
+
+    if (hidden != nullptr) {
+      placeCell(*hidden, m_focused_row, m_focused_column);
+    }
+  }
+
+  void GridView::placeCell(Widget& widget, std::size_t row, std::size_t column) {
+    sf::FloatRect geometry = getGeometry();
+
+    Geometry vertical;
+    vertical.start = geometry.top + row * m_row_height - m_offset.y;
+    vertical.size = m_row_height;
+
+    Geometry horizontal;
+    horizontal.start = geometry.left + m_column_starts[column] - m_offset.x;
+    horizontal.size = getColumnWidth(column);
+
+    widget.updateLayoutRequest();
+
+    computeGeometry(vertical, widget.getVerticalGeometry());
+    computeGeometry(horizontal, widget.getHorizontalGeometry());
+
+    widget.updateLayoutAllocation();
+  }
+
+}
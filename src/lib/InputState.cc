@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2014, Julien Bernard
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#include <ui/InputState.h>
+
+namespace ui {
+
+  constexpr std::size_t InputState::NoIndex;
+
+  static constexpr std::size_t MouseButtonOffset = InputState::KeyCount;
+  static constexpr std::size_t GamepadButtonOffset = MouseButtonOffset + InputState::MouseButtonCount;
+  static constexpr std::size_t CloseOffset = GamepadButtonOffset + InputState::GamepadCount * InputState::GamepadButtonCount;
+
+  static EventSource keySource(sf::Keyboard::Key key) {
+    EventSource source;
+    source.type = EventSource::Type::KEY;
+    source.code = key;
+    return source;
+  }
+
+  static EventSource mouseButtonSource(sf::Mouse::Button button) {
+    EventSource source;
+    source.type = EventSource::Type::MOUSE_BUTTON;
+    source.code = button;
+    return source;
+  }
+
+  static EventSource gamepadButtonSource(unsigned int id, unsigned int button) {
+    EventSource source;
+    source.type = EventSource::Type::GAMEPAD_BUTTON;
+    source.id = id;
+    source.code = button;
+    return source;
+  }
+
+  std::size_t InputState::getIndex(const EventSource& source) {
+    switch (source.type) {
+      case EventSource::Type::KEY:
+        if (source.code < KeyCount) {
+          return source.code;
+        }
+        break;
+      case EventSource::Type::MOUSE_BUTTON:
+        if (source.code < MouseButtonCount) {
+          return MouseButtonOffset + source.code;
+        }
+        break;
+      case EventSource::Type::GAMEPAD_BUTTON:
+        if (source.id < GamepadCount && source.code < GamepadButtonCount) {
+          return GamepadButtonOffset + source.id * GamepadButtonCount + source.code;
+        }
+        break;
+      case EventSource::Type::CLOSE:
+        return CloseOffset;
+      default:
+        break;
+    }
+
+    return NoIndex;
+  }
+
+  void InputState::update(const sf::Event& event) {
+    if (event.type == sf::Event::LostFocus) {
+      // the release events are sent to another window, so all the held
+      // buttons are released now, except the close button
+      Mask held = m_pressed;
+      held.reset(CloseOffset);
+      m_pressed &= ~held;
+      m_just_released |= held;
+      return;
+    }
+
+    std::size_t index = getIndex(EventSource::fromEvent(event));
+
+    if (index == NoIndex) {
+      return;
+    }
+
+    switch (event.type) {
+      case sf::Event::KeyPressed:
+      case sf::Event::MouseButtonPressed:
+      case sf::Event::JoystickButtonPressed:
+      case sf::Event::Closed:
+        m_pressed.set(index);
+        m_just_pressed.set(index);
+        break;
+      case sf::Event::KeyReleased:
+      case sf::Event::MouseButtonReleased:
+      case sf::Event::JoystickButtonReleased:
+        m_pressed.reset(index);
+        m_just_released.set(index);
+        break;
+      default:
+        break;
+    }
+  }
+
+  void InputState::nextFrame() {
+    m_just_pressed.reset();
+    m_just_released.reset();
+  }
+
+  bool InputState::test(const Mask& mask, const EventSource& source) {
+    std::size_t index = getIndex(source);
+    return index != NoIndex && mask.test(index);
+  }
+
+  bool InputState::isKeyPressed(sf::Keyboard::Key key) const {
+    return test(m_pressed, keySource(key));
+  }
+
+  bool InputState::isKeyJustPressed(sf::Keyboard::Key key) const {
+    return test(m_just_pressed, keySource(key));
+  }
+
+  bool InputState::isKeyJustReleased(sf::Keyboard::Key key) const {
+    return test(m_just_released, keySource(key));
+  }
+
+  bool InputState::isMouseButtonPressed(sf::Mouse::Button button) const {
+    return test(m_pressed, mouseButtonSource(button));
+  }
+
+  bool InputState::isMouseButtonJustPressed(sf::Mouse::Button button) const {
+    return test(m_just_pressed, mouseButtonSource(button));
+  }
+
+  bool InputState::isMouseButtonJustReleased(sf::Mouse::Button button) const {
+    return test(m_just_released, mouseButtonSource(button));
+  }
+
+  bool InputState::isGamepadButtonPressed(unsigned int id, unsigned int button) const {
+    return test(m_pressed, gamepadButtonSource(id, button));
+  }
+
+  bool InputState::isGamepadButtonJustPressed(unsigned int id, unsigned int button) const {
+    return test(m_just_pressed, gamepadButtonSource(id, button));
+  }
+
+  bool InputState::isGamepadButtonJustReleased(unsigned int id, unsigned int button) const {
+    return test(m_just_released, gamepadButtonSource(id, button));
+  }
+
+  bool InputState::isClosed() const {
+    return m_pressed.test(CloseOffset);
+  }
+
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2014, Julien Bernard
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#include <ui/LeafIndex.h>
+
+#include <cassert>
+#include <algorithm>
+#include <cmath>
+
+namespace ui {
+
+  void LeafIndex::clear() {
+    m_leaves.clear();
+    m_geometry.clear();
+    m_cells.clear();
+    m_items.clear();
+    m_cols = m_rows = 0;
+  }
+
+  void LeafIndex::addLeaf(Leaf *leaf) {
+    m_leaves.push_back(leaf);
+    m_geometry.push_back(leaf->getGeometry());
+  }
+
+  void LeafIndex::build(const sf::FloatRect& bounds) {
+    m_bounds = bounds;
+
+    m_cells.clear();
+    m_items.clear();
+
+    if (m_leaves.empty() || bounds.width <= 0 || bounds.height <= 0) {
+      m_cols = m_rows = 0;
+      return;
+    }
+
+    /*
+     * choose about one cell per leaf, with cells that have the same aspect
+     * ratio as the bounds
+     */
+
+    float count = static_cast<float>(m_leaves.size());
+    float cols = std::ceil(std::sqrt(count * bounds.width / bounds.height));
+    float rows = std::ceil(count / cols);
+
+    m_cols = static_cast<std::size_t>(cols);
+    m_rows = static_cast<std::size_t>(rows);
+    m_cell_width = bounds.width / m_cols;
+    m_cell_height = bounds.height / m_rows;
+
+    /*
+     * count the leaves in each cell, then fill the cells
+     */
+
+    m_cells.resize(m_cols * m_rows + 1, 0);
+
+    for (auto& geometry : m_geometry) {
+      std::size_t c0 = cellColumn(geometry.left);
+      std::size_t c1 = cellColumn(geometry.left + geometry.width);
+      std::size_t r0 = cellRow(geometry.top);
+      std::size_t r1 = cellRow(geometry.top + geometry.height);
+
+      for (std::size_t r = r0; r <= r1; ++r) {
+        for (std::size_t c = c0; c <= c1; ++c) {
+          m_cells[r * m_cols + c + 1]++;
+        }
+      }
+    }
+
+    for (std::size_t i = 1; i < m_cells.size(); ++i) {
+      m_cells[i] += m_cells[i - 1];
+    }
+
+    m_items.resize(m_cells.back());
+
+    m_next.assign(m_cells.begin(), m_cells.end() - 1);
+
+    for (std::size_t i = 0; i < m_geometry.size(); ++i) {
+      auto& geometry = m_geometry[i];
+      std::size_t c0 = cellColumn(geometry.left);
+      std::size_t c1 = cellColumn(geometry.left + geometry.width);
+      std::size_t r0 = cellRow(geometry.top);
+      std::size_t r1 = cellRow(geometry.top + geometry.height);
+
+      for (std::size_t r = r0; r <= r1; ++r) {
+        for (std::size_t c = c0; c <= c1; ++c) {
+          m_items[m_next[r * m_cols + c]++] = i;
+        }
+      }
+    }
+  }
+
+  Leaf *LeafIndex::find(const sf::Vector2f& point) const {
+    if (m_cells.empty() || !m_bounds.contains(point)) {
+      return nullptr;
+    }
+
+    std::size_t cell = cellRow(point.y) * m_cols + cellColumn(point.x);
+
+    // the leaves of a cell are sorted in the order they were added
+    for (std::size_t i = m_cells[cell]; i < m_cells[cell + 1]; ++i) {
+      std::size_t item = m_items[i];
+
+      if (m_geometry[item].contains(point)) {
+        return m_leaves[item];
+      }
+    }
+
+    return nullptr;
+  }
+
+  std::size_t LeafIndex::cellColumn(float x) const {
+    assert(m_cols > 0);
+    float c = std::floor((x - m_bounds.left) / m_cell_width);
+
+    if (c < 0) {
+      return 0;
+    }
+
+    return std::min(static_cast<std::size_t>(c), m_cols - 1);
+  }
+
+  std::size_t LeafIndex::cellRow(float y) const {
+    assert(m_rows > 0);
+    float r = std::floor((y - m_bounds.top) / m_cell_height);
+
+    if (r < 0) {
+      return 0;
+    }
+
+    return std::min(static_cast<std::size_t>(r), m_rows - 1);
+  }
+
+}
@@ -0,0 +1,354 @@
+/*
+ * Copyright (c) 2014, Julien Bernard
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#include <ui/ListView.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include <ui/WidgetVisitor.h>
+
+namespace ui {
+
+  ListModel::~ListModel() {
+  }
+
+  constexpr std::size_t ListView::NoRow;
+
+  ListView::ListView(ListModel& model, float row_height)
+  : m_model(model)
+  , m_row_height(row_height)
+  , m_offset(0.0f)
+  , m_first(0)
+  , m_bind_first(0)
+  , m_focused_row(NoRow)
+  , m_focused_widget(nullptr)
+  , m_reveal_needed(false)
+  {
+    setSizePolicy(SizePolicy::MINIMUM, SizePolicy::MINIMUM);
+  }
+
+  ListView::~ListView() {
+    delete getHiddenFocusedRow();
+
+    for (auto row : m_rows) {
+      delete row;
+    }
+
+    for (auto row : m_spare_rows) {
+      delete row;
+    }
+  }
+
+  void ListView::setRowHeight(float row_height) {
+    m_row_height = row_height;
+    invalidateLayout();
+  }
+
+  void ListView::invalidateRows(std::size_t first) {
+    m_bind_first = std::min(m_bind_first, first);
+
+    // the number of rows may have changed
+    invalidateLayout();
+    invalidateRendering();
+    invalidateFocus();
+  }
+
+  void ListView::setOffset(float offset) {
+    offset = clampOffset(offset);
+
+    if (offset == m_offset) {
+      return;
+    }
+
+    // the layout of the list view does not change, only the rows move
+    m_offset = offset;
+    updateRows();
+
+    invalidateRendering();
+    invalidateFocus();
+  }
+
+  void ListView::scrollToRow(std::size_t index) {
+    float top = index * m_row_height;
+    float height = getGeometry().height;
+
+    if (top < m_offset) {
+      setOffset(top);
+    } else if (top + m_row_height > m_offset + height) {
+      setOffset(top + m_row_height - height);
+    }
+  }
+
+  Widget *ListView::getHiddenFocusedRow() const {
+    if (m_focused_widget == nullptr) {
+      return nullptr;
+    }
+
+    if (m_first <= m_focused_row && m_focused_row < m_first + m_rows.size()) {
+      return nullptr;
+    }
+
+    return m_focused_widget;
+  }
+
+  void ListView::onClick(sf::Mouse::Button button, const sf::Vector2f& mouse) {
+    if (!getGeometry().contains(mouse) || m_row_height <= 0.0f) {
+      return;
+    }
+
+    // the rows are contiguous, no need to look at each of them
+    float position = mouse.y - getGeometry().top + m_offset;
+    std::size_t index = static_cast<std::size_t>(position / m_row_height);
+
+    if (index < m_first || index >= m_first + m_rows.size()) {
+      return;
+    }
+
+    Widget *row = m_rows[index - m_first];
+
+    if (row->getGeometry().contains(mouse)) {
+      row->onClick(button, mouse);
+    }
+  }
+
+  void ListView::layoutRequest() {
+    // the size hint of the rows is not used: it is the purpose of a list
+    // view to be smaller than its rows
+  }
+
+  void ListView::layoutAllocation() {
+    float offset = clampOffset(m_offset);
+
+    if (m_reveal_needed && m_focused_row != NoRow) {
+      offset = clampOffset(revealOffset(m_focused_row));
+    }
+
+    m_reveal_needed = false;
+
+    if (offset != m_offset) {
+      m_offset = offset;
+      invalidateRendering();
+      invalidateFocus();
+    }
+
+    // the number of visible rows depends on the height of the list view
+    updateRows();
+  }
+
+  void ListView::addDamage(const sf::FloatRect& rectangle) {
+    sf::FloatRect damage;
+
+    // the part of the rows outside the list view is not visible
+    if (!rectangle.intersects(getGeometry(), damage)) {
+      return;
+    }
+
+    Widget *parent = getParent();
+
+    if (parent != nullptr) {
+      parent->addDamage(damage);
+    }
+  }
+
+  void ListView::childFocusChanged(Widget& child, Leaf& leaf, bool focused) {
+    std::size_t index = NoRow;
+
+    if (&child == m_focused_widget) {
+      index = m_focused_row;
+    } else {
+      auto it = std::find(m_rows.begin(), m_rows.end(), &child);
+
+      if (it != m_rows.end()) {
+        index = m_first + (it - m_rows.begin());
+      }
+    }
+
+    if (index != NoRow) {
+      if (focused) {
+        m_focused_row = index;
+        m_focused_widget = &child;
+
+        // the focus only moves to the visible rows, so the next rows are
+        // shown when the focus reaches the first or the last visible row,
+        // unless there is no row before or after
+        bool top_edge = index <= m_first && index > 0;
+        bool bottom_edge = index + 1 >= m_first + m_rows.size() && index + 1 < m_model.getRowCount();
+
+        if (top_edge || bottom_edge) {
+          m_reveal_needed = true;
+          invalidateLayout();
+        }
+      } else if (index == m_focused_row) {
+        Widget *hidden = getHiddenFocusedRow();
+
+        if (hidden != nullptr) {
+          m_spare_rows.push_back(hidden);
+        }
+
+        m_focused_row = NoRow;
+        m_focused_widget = nullptr;
+      }
+    }
+
+    Widget::childFocusChanged(child, leaf, focused);
+  }
+
+  void ListView::accept(WidgetVisitor& visitor) {
+    visitor.visitListView(*this);
+  }
+
+  float ListView::clampOffset(float offset) const {
+    float content = m_model.getRowCount() * m_row_height;
+    float max_offset = std::max(content - getGeometry().height, 0.0f);
+    return std::min(std::max(offset, 0.0f), max_offset);
+  }
+
+  float ListView::revealOffset(std::size_t index) const {
+    // the neighbours of the row are shown if there is enough room
+    std::size_t count = m_model.getRowCount();
+    float top = (index > 0 ? index - 1 : index) * m_row_height;
+    float bottom = std::min(index + 2, count) * m_row_height;
+    float height = getGeometry().height;
+
+    if (bottom - top > height) {
+      top = index * m_row_height;
+      bottom = top + m_row_height;
+    }
+
+    float offset = m_offset;
+
+    if (bottom > offset + height) {
+      offset = bottom - height;
+    }
+
+    if (top < offset) {
+      offset = top;
+    }
+
+    return offset;
+  }
+
+  void ListView::updateRows() {
+    std::size_t count = m_model.getRowCount();
+    std::size_t first = 0;
+    std::size_t last = 0;
+
+    if (count > 0 && m_row_height > 0.0f) {
+      float height = getGeometry().height;
+      first = std::min(static_cast<std::size_t>(m_offset / m_row_height), count);
+      last = std::min(static_cast<std::size_t>(std::ceil((m_offset + height) / m_row_height)), count);
+    }
+
+    if (m_focused_row != NoRow && m_focused_row >= count) {
+      // the focused row has been removed
+      m_focused_row = NoRow;
+    }
+
+    // keep the widgets of the rows that are still visible, and recycle the
+    // others, except the widget of the focused row
+    m_next_rows.assign(last - first, nullptr);
+    bool focused_kept = false;
+
+    for (std::size_t i = 0; i < m_rows.size(); ++i) {
+      std::size_t index = m_first + i;
+
+      if (index < m_bind_first && first <= index && index < last) {
+        m_next_rows[index - first] = m_rows[i];
+        focused_kept = focused_kept || m_rows[i] == m_focused_widget;
+      } else if (m_rows[i] != m_focused_widget) {
+        m_spare_rows.push_back(m_rows[i]);
+      }
+    }
+
+    if (m_focused_widget != nullptr && !focused_kept) {
+      if (m_focused_row == NoRow) {
+        m_spare_rows.push_back(m_focused_widget);
+      } else {
+        if (m_focused_row >= m_bind_first) {
+          bindRow(*m_focused_widget, m_focused_row);
+        }
+
+        if (first <= m_focused_row && m_focused_row < last) {
+          m_next_rows[m_focused_row - first] = m_focused_widget;
+        }
+      }
+    }
+
+    if (m_focused_row == NoRow) {
+      m_focused_widget = nullptr;
+    }
+
+    for (std::size_t i = 0; i < m_next_rows.size(); ++i) {
+      if (m_next_rows[i] != nullptr) {
+        continue;
+      }
+
+      Widget *row = nullptr;
+
+      if (m_spare_rows.empty()) {
+        row = m_model.createRow();
+      } else {
+        row = m_spare_rows.back();
+        m_spare_rows.pop_back();
+      }
+
+      bindRow(*row, first + i);
+      m_next_rows[i] = row;
+    }
+
+    m_rows.swap(m_next_rows);
+    m_first = first;
+    m_bind_first = static_cast<std::size_t>(-1);
+
+    placeRows();
+  }
+
+  void ListView::bindRow(Widget& widget, std::size_t index) {
+    // the row is detached while it is updated so that its changes do not
+    // invalidate the whole hierarchy: the list view takes care of the row
+    widget.setParent(nullptr);
+    m_model.updateRow(widget, index, index == m_focused_row);
+    widget.setParent(this);
+  }
+
+  void ListView::placeRows() {
+    for (std::size_t i = 0; i < m_rows.size(); ++i) {
+      placeRow(*m_rows[i], m_first + i);
+    }
+
+    // the hidden focused row is placed where it would be, so that the focus
+    // can move from it to the visible rows
+    Widget *hidden = getHiddenFocusedRow();
+
+    if (hidden != nullptr) {
+      placeRow(*hidden, m_focused_row);
+    }
+  }
+
+  void ListView::placeRow(Widget& widget, std::size_t index) {
+    Geometry vertical;
+    vertical.start = getGeometry().top + index * m_row_height - m_offset;
+    vertical.size = m_row_height;
+
+    widget.updateLayoutRequest();
+
+    computeGeometry(vertical, widget.getVerticalGeometry());
+    computeGeometry(getHorizontalGeometry(), widget.getHorizontalGeometry());
+
+    widget.updateLayoutAllocation();
+  }
+
+}
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2014, Julien Bernard
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#include <ui/MainLoop.h>
+
+#include <algorithm>
+
+namespace ui {
+
+  // the granularity of the wait when a timer is pending
+  static const sf::Time WaitStep = sf::milliseconds(10);
+
+  MainLoop::MainLoop(sf::Window& window, Area& area, StandardActionSet& actions)
+  : m_window(window)
+  , m_area(area)
+  , m_actions(actions)
+  , m_draw_needed(true)
+  , m_iteration_count(0)
+  , m_draw_count(0)
+  , m_idle_time(sf::Time::Zero)
+  {
+  }
+
+  void MainLoop::addTimer(sf::Time delay, Callback callback) {
+    Timer timer;
+    timer.deadline = m_clock.getElapsedTime() + delay;
+    timer.callback = std::move(callback);
+    m_timers.push_back(std::move(timer));
+  }
+
+  void MainLoop::run() {
+    while (m_window.isOpen()) {
+      sf::Event event;
+
+      if (isIdle()) {
+        sf::Time start = m_clock.getElapsedTime();
+
+        if (waitEvent(event)) {
+          m_queue.pushEvent(event);
+        }
+
+        m_idle_time += m_clock.getElapsedTime() - start;
+      }
+
+      while (m_window.pollEvent(event)) {
+        m_queue.pushEvent(event);
+      }
+
+      while (m_queue.pollEvent(event)) {
+        handleEvent(event);
+      }
+
+      runTimers();
+
+      if (m_update_callback) {
+        m_update_callback();
+      }
+
+      m_actions.handleArea(m_area);
+      m_actions.reset();
+
+      ++m_iteration_count;
+
+      if (!m_window.isOpen()) {
+        break;
+      }
+
+      if (m_area.isLayoutRequestNeeded() || m_area.isLayoutAllocationNeeded()) {
+        m_area.updateLayout();
+      }
+
+      if (m_draw_needed || m_area.isDamaged()) {
+        if (m_draw_callback) {
+          m_draw_callback();
+        }
+
+        m_window.display();
+        m_area.clearDamage();
+        m_draw_needed = false;
+        ++m_draw_count;
+      }
+    }
+  }
+
+  bool MainLoop::isIdle() const {
+    return !m_draw_needed && !m_area.isDamaged() && !m_area.isLayoutRequestNeeded() && !m_area.isLayoutAllocationNeeded();
+  }
+
+  bool MainLoop::waitEvent(sf::Event& event) {
+    if (m_timers.empty()) {
+      return m_window.waitEvent(event);
+    }
+
+    // sf::Window::waitEvent() has no timeout, so wait for the next timer by
+    // small steps
+    auto next = std::min_element(m_timers.begin(), m_timers.end(), [](const Timer& lhs, const Timer& rhs) {
+      return lhs.deadline < rhs.deadline;
+    });
+
+    sf::Time deadline = next->deadline;
+
+    for (;;) {
+      if (m_window.pollEvent(event)) {
+        return true;
+      }
+
+      sf::Time now = m_clock.getElapsedTime();
+
+      if (now >= deadline) {
+        return false;
+      }
+
+      sf::sleep(std::min(deadline - now, WaitStep));
+    }
+  }
+
+  void MainLoop::handleEvent(const sf::Event& event) {
+    m_actions.update(event);
+
+    switch (event.type) {
+      case sf::Event::MouseButtonPressed:
+        m_area.onClick(event.mouseButton.button, { static_cast<float>(event.mouseButton.x), static_cast<float>(event.mouseButton.y) });
+        break;
+
+      case sf::Event::Resized:
+      case sf::Event::GainedFocus:
+        // the content of the window may have been lost
+        m_draw_needed = true;
+        break;
+
+      default:
+        break;
+    }
+  }
+
+  void MainLoop::runTimers() {
+    if (m_timers.empty()) {
+      return;
+    }
+
+    sf::Time now = m_clock.getElapsedTime();
+
+    // the callbacks may add new timers, so the expired timers are removed first
+    for (std::size_t i = 0; i < m_timers.size(); ) {
+      if (m_timers[i].deadline <= now) {
+        m_expired.push_back(std::move(m_timers[i]));
+        m_timers[i] = std::move(m_timers.back());
+        m_timers.pop_back();
+      } else {
+        ++i;
+      }
+    }
+
+    for (auto& timer : m_expired) {
+      timer.callback();
+    }
+
+    m_expired.clear();
+  }
+
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2014, Julien Bernard
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#include <ui/RenderCommandList.h>
+
+#include <ostream>
+
+namespace ui {
+
+  void RenderCommandList::addCommand(RenderCommandType type, Widget& widget, const sf::FloatRect& geometry, const sf::Color& color, bool focused) {
+    RenderCommand command;
+    command.type = type;
+    command.focused = focused;
+    command.geometry = geometry;
+    command.color = color;
+    command.widget = &widget;
+    command.text_start = 0;
+    command.text_length = 0;
+    m_commands.push_back(command);
+  }
+
+  void RenderCommandList::addRectangle(Widget& widget, const sf::FloatRect& geometry, const sf::Color& color) {
+    addCommand(RenderCommandType::RECTANGLE, widget, geometry, color, false);
+  }
+
+  void RenderCommandList::addOutline(Widget& widget, const sf::FloatRect& geometry, const sf::Color& color, bool focused) {
+    addCommand(RenderCommandType::OUTLINE, widget, geometry, color, focused);
+  }
+
+  void RenderCommandList::addText(Widget& widget, const sf::FloatRect& geometry, const sf::Color& color, const std::string& text) {
+    addCommand(RenderCommandType::TEXT, widget, geometry, color, false);
+
+    RenderCommand& command = m_commands.back();
+    command.text_start = m_characters.size();
+    command.text_length = text.size();
+    m_characters.insert(m_characters.end(), text.begin(), text.end());
+  }
+
+  void RenderCommandList::addCache(Widget& widget, const sf::FloatRect& geometry) {
+    addCommand(RenderCommandType::CACHE, widget, geometry, sf::Color::Transparent, false);
+  }
+
+  void RenderCommandList::addClipBegin(Widget& widget, const sf::FloatRect& geometry) {
+    addCommand(RenderCommandType::CLIP_BEGIN, widget, geometry, sf::Color::Transparent, false);
+  }
+
+  void RenderCommandList::addClipEnd(Widget& widget) {
+    addCommand(RenderCommandType::CLIP_END, widget, sf::FloatRect(), sf::Color::Transparent, false);
+  }
+
+  static const char *getTypeName(RenderCommandType type) {
+    switch (type) {
+      case RenderCommandType::RECTANGLE:
+        return "rectangle";
+      case RenderCommandType::OUTLINE:
+        return "outline";
+      case RenderCommandType::TEXT:
+        return "text";
+      case RenderCommandType::CACHE:
+        return "cache";
+      case RenderCommandType::CLIP_BEGIN:
+        return "clip-begin";
+      case RenderCommandType::CLIP_END:
+        return "clip-end";
+    }
+
+    return "unknown";
+  }
+
+  void RenderCommandList::dump(std::ostream& out) const {
+    for (auto& command : m_commands) {
+      out << getTypeName(command.type)
+          << ' ' << command.geometry.left << ' ' << command.geometry.top
+          << ' ' << command.geometry.width << ' ' << command.geometry.height
+          << " #" << static_cast<unsigned>(command.color.r)
+          << ',' << static_cast<unsigned>(command.color.g)
+          << ',' << static_cast<unsigned>(command.color.b)
+          << ',' << static_cast<unsigned>(command.color.a);
+
+      if (command.focused) {
+        out << " focused";
+      }
+
+      if (command.type == RenderCommandType::TEXT) {
+        out << " \"";
+        out.write(getText(command), command.text_length);
+        out << '"';
+      }
+
+      out << '\n';
+    }
+  }
+
+}
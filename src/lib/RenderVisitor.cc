@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2014, Julien Bernard
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#include <ui/RenderVisitor.h>
+
+namespace ui {
+
+  static const sf::Color BinColor(0xE0, 0xE0, 0xE0);
+  static const sf::Color SelectedColor(0x80, 0x80, 0x80);
+
+  void RenderVisitor::visitBinContent(Bin& widget) {
+    if (!widget.hasChild()) {
+      return;
+    }
+
+    // the bin may be the root of the visit
+    if (getClip() != nullptr && isCulled(widget)) {
+      return;
+    }
+
+    addBox(widget, widget.getGeometry(), BinColor, sf::Color::Black, false);
+    visitBinChild(widget);
+  }
+
+  void RenderVisitor::visitArea(Area& widget) {
+    visitStackTopChild(widget);
+  }
+
+  void RenderVisitor::visitBin(Bin& widget) {
+    if (!widget.isCached()) {
+      visitBinContent(widget);
+      return;
+    }
+
+    if (!widget.hasChild() || (getClip() != nullptr && isCulled(widget))) {
+      return;
+    }
+
+    m_commands.addCache(widget, toScreen(widget.getGeometry()));
+  }
+
+  void RenderVisitor::visitButton(Button& widget) {
+    auto geometry = widget.getInternalGeometry();
+
+    bool focused = widget.isFocused();
+    addBox(widget, geometry, sf::Color::White, focused ? sf::Color::Red : sf::Color::Black, focused);
+    m_commands.addText(widget, toScreen(geometry), sf::Color::Black, widget.getText());
+  }
+
+  void RenderVisitor::visitForm(Form& widget) {
+    visitContainerChildren(widget);
+  }
+
+  void RenderVisitor::visitGridView(GridView& widget) {
+    if (widget.getVisibleCellCount() == 0) {
+      return;
+    }
+
+    // the cells on the sides may be partially visible
+    m_commands.addClipBegin(widget, toScreen(widget.getGeometry()));
+    visitGridViewCells(widget);
+    m_commands.addClipEnd(widget);
+  }
+
+  void RenderVisitor::visitHBox(HBox& widget) {
+    visitContainerChildren(widget);
+  }
+
+  void RenderVisitor::visitLabel(Label& widget) {
+    auto geometry = widget.getInternalGeometry();
+
+    addBox(widget, geometry, sf::Color::White, sf::Color::Black, false);
+    m_commands.addText(widget, toScreen(geometry), sf::Color::Black, widget.getText());
+  }
+
+  void RenderVisitor::visitListView(ListView& widget) {
+    if (widget.getVisibleRowCount() == 0) {
+      return;
+    }
+
+    // the first and the last rows may be partially visible
+    m_commands.addClipBegin(widget, toScreen(widget.getGeometry()));
+    visitListViewRows(widget);
+    m_commands.addClipEnd(widget);
+  }
+
+  void RenderVisitor::visitScrollArea(ScrollArea& widget) {
+    if (!widget.hasChild()) {
+      return;
+    }
+
+    m_commands.addClipBegin(widget, toScreen(widget.getGeometry()));
+    visitScrollAreaChild(widget);
+    m_commands.addClipEnd(widget);
+  }
+
+  void RenderVisitor::visitSelect(Select& widget) {
+    auto geometry = widget.getInternalGeometry();
+
+    bool focused = widget.isFocused();
+    addBox(widget, geometry, sf::Color::White, focused ? sf::Color::Red : sf::Color::Black, focused);
+    m_commands.addText(widget, toScreen(geometry), sf::Color::Black, widget.getSelectedName());
+  }
+
+  void RenderVisitor::visitStack(Stack& widget) {
+    visitStackTopChild(widget);
+  }
+
+  void RenderVisitor::visitTable(Table& widget) {
+    visitContainerChildren(widget);
+  }
+
+  void RenderVisitor::visitToggle(Toggle& widget) {
+    auto geometry = widget.getInternalGeometry();
+
+    bool focused = widget.isFocused();
+    addBox(widget, geometry, widget.isSelected() ? SelectedColor : sf::Color::White, focused ? sf::Color::Red : sf::Color::Black, focused);
+  }
+
+  void RenderVisitor::visitVBox(VBox& widget) {
+    visitContainerChildren(widget);
+  }
+
+  bool RenderVisitor::isCulled(const Widget& widget) const {
+    // the outline is outside the geometry
+    auto geometry = widget.getGeometry();
+    sf::FloatRect outer(geometry.left - 1, geometry.top - 1, geometry.width + 2, geometry.height + 2);
+    return !getClip()->intersects(outer);
+  }
+
+  void RenderVisitor::addBox(Widget& widget, const sf::FloatRect& geometry, const sf::Color& fill, const sf::Color& outline, bool focused) {
+    sf::FloatRect screen = toScreen(geometry);
+    m_commands.addRectangle(widget, screen, fill);
+    m_commands.addOutline(widget, screen, outline, focused);
+  }
+
+  sf::FloatRect RenderVisitor::toScreen(const sf::FloatRect& geometry) const {
+    const sf::Vector2f& translation = getTranslation();
+    return { geometry.left - translation.x, geometry.top - translation.y, geometry.width, geometry.height };
+  }
+
+}
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2014, Julien Bernard
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#include <ui/ScrollArea.h>
+
+#include <algorithm>
+
+#include <ui/Leaf.h>
+#include <ui/WidgetVisitor.h>
+
+namespace ui {
+
+  ScrollArea::ScrollArea()
+  : m_child(nullptr)
+  , m_offset(0.0f, 0.0f)
+  , m_reveal_needed(false)
+  {
+    setSizePolicy(SizePolicy::MINIMUM, SizePolicy::MINIMUM);
+  }
+
+  ScrollArea::~ScrollArea() {
+    delete m_child;
+  }
+
+  void ScrollArea::setChild(Widget *child) {
+    m_child = child;
+
+    if (m_child != nullptr) {
+      m_child->setParent(this);
+    }
+
+    invalidateLayout();
+    invalidateFocus();
+
+    // the whole visible content changes
+    invalidateRendering();
+  }
+
+  void ScrollArea::setOffset(const sf::Vector2f& offset) {
+    sf::Vector2f clamped = clampOffset(offset);
+
+    if (clamped == m_offset) {
+      return;
+    }
+
+    m_offset = clamped;
+
+    // the whole scroll area must be drawn again, and other widgets may now
+    // be focusable
+    invalidateRendering();
+    invalidateFocus();
+  }
+
+  void ScrollArea::scrollTo(const sf::FloatRect& rectangle) {
+    sf::FloatRect geometry = getGeometry();
+    sf::FloatRect visible = getVisibleContent();
+    sf::Vector2f offset = m_offset;
+
+    if (rectangle.left + rectangle.width > visible.left + visible.width) {
+      offset.x = rectangle.left + rectangle.width - geometry.left - geometry.width;
+    }
+
+    if (rectangle.left < visible.left || rectangle.width > geometry.width) {
+      offset.x = rectangle.left - geometry.left;
+    }
+
+    if (rectangle.top + rectangle.height > visible.top + visible.height) {
+      offset.y = rectangle.top + rectangle.height - geometry.top - geometry.height;
+    }
+
+    if (rectangle.top < visible.top || rectangle.height > geometry.height) {
+      offset.y = rectangle.top - geometry.top;
+    }
+
+    setOffset(offset);
+  }
+
+  sf::Vector2f ScrollArea::getContentSize() const {
+    if (!hasChild()) {
+      return { 0.0f, 0.0f };
+    }
+
+    sf::FloatRect content = m_child->getGeometry();
+    return { content.width, content.height };
+  }
+
+  sf::FloatRect ScrollArea::getVisibleContent() const {
+    sf::FloatRect geometry = getGeometry();
+    return { geometry.left + m_offset.x, geometry.top + m_offset.y, geometry.width, geometry.height };
+  }
+
+  void ScrollArea::onClick(sf::Mouse::Button button, const sf::Vector2f& mouse) {
+    if (hasChild() && getGeometry().contains(mouse)) {
+      m_child->onClick(button, mouse + m_offset);
+    }
+  }
+
+  void ScrollArea::layoutRequest() {
+    if (!hasChild()) {
+      return;
+    }
+
+    // the size hint of the child is not forwarded: it is the purpose of a
+    // scroll area to be smaller than its child
+    m_child->updateLayoutRequest();
+  }
+
+  void ScrollArea::layoutAllocation() {
+    if (!hasChild()) {
+      return;
+    }
+
+    // the child gets at least the size of the scroll area
+    Geometry vertical = getVerticalGeometry();
+    vertical.size = std::max(vertical.size, m_child->getVerticalGeometry().hint);
+    computeGeometry(vertical, m_child->getVerticalGeometry());
+
+    Geometry horizontal = getHorizontalGeometry();
+    horizontal.size = std::max(horizontal.size, m_child->getHorizontalGeometry().hint);
+    computeGeometry(horizontal, m_child->getHorizontalGeometry());
+
+    m_child->updateLayoutAllocation();
+
+    // the content may have shrunk
+    setOffset(m_offset);
+
+    if (m_reveal_needed) {
+      m_reveal_needed = false;
+      scrollTo(m_reveal);
+    }
+  }
+
+  void ScrollArea::addDamage(const sf::FloatRect& rectangle) {
+    sf::FloatRect damage(rectangle.left - m_offset.x, rectangle.top - m_offset.y, rectangle.width, rectangle.height);
+
+    // the damage outside the scroll area is not visible
+    if (!damage.intersects(getGeometry(), damage)) {
+      return;
+    }
+
+    Widget *parent = getParent();
+
+    if (parent != nullptr) {
+      parent->addDamage(damage);
+    }
+  }
+
+  void ScrollArea::childFocusChanged(Widget& child, Leaf& leaf, bool focused) {
+    if (focused) {
+      sf::FloatRect reveal = revealRectangle(leaf.getGeometry());
+      sf::FloatRect visible = getVisibleContent();
+
+      // the offset changes at the next layout, like the rows of a list view
+      bool shown = visible.left <= reveal.left && reveal.left + reveal.width <= visible.left + visible.width
+          && visible.top <= reveal.top && reveal.top + reveal.height <= visible.top + visible.height;
+
+      if (!shown) {
+        m_reveal = reveal;
+        m_reveal_needed = true;
+        invalidateLayout();
+      }
+    }
+
+    Widget::childFocusChanged(child, leaf, focused);
+  }
+
+  void ScrollArea::accept(WidgetVisitor& visitor) {
+    visitor.visitScrollArea(*this);
+  }
+
+  sf::Vector2f ScrollArea::clampOffset(const sf::Vector2f& offset) const {
+    sf::FloatRect geometry = getGeometry();
+    sf::Vector2f content = getContentSize();
+
+    float max_x = std::max(content.x - geometry.width, 0.0f);
+    float max_y = std::max(content.y - geometry.height, 0.0f);
+
+    return { std::min(std::max(offset.x, 0.0f), max_x), std::min(std::max(offset.y, 0.0f), max_y) };
+  }
+
+  sf::FloatRect ScrollArea::revealRectangle(const sf::FloatRect& rectangle) const {
+    if (!hasChild()) {
+      return rectangle;
+    }
+
+    // the neighbours of the leaf are shown if there is enough room, assuming
+    // they have the size of the leaf
+    sf::FloatRect geometry = getGeometry();
+    sf::FloatRect content = m_child->getGeometry();
+
+    float left = std::max(rectangle.left - rectangle.width, content.left);
+    float right = std::min(rectangle.left + 2 * rectangle.width, content.left + content.width);
+
+    if (right - left > geometry.width) {
+      left = rectangle.left;
+      right = rectangle.left + rectangle.width;
+    }
+
+    float top = std::max(rectangle.top - rectangle.height, content.top);
+    float bottom = std::min(rectangle.top + 2 * rectangle.height, content.top + content.height);
+
+    if (bottom - top > geometry.height) {
+      top = rectangle.top;
+      bottom = rectangle.top + rectangle.height;
+    }
+
+    return { left, top, right - left, bottom - top };
+  }
+
+}
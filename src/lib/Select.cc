@@ -30,6 +30,7 @@ namespace ui {
 
   void Select::addValue(std::string name, index_type index) {
     m_values.emplace_back(std::move(name), index);
+    invalidateRendering();
   }
 
   const std::string& Select::getSelectedName() const {
@@ -48,6 +49,8 @@ namespace ui {
     if (m_selected == m_values.size()) {
       m_selected = 0;
     }
+
+    invalidateRendering();
   }
 
   void Select::pickPreviousValue() {
@@ -56,6 +59,7 @@ namespace ui {
     }
 
     --m_selected;
+    invalidateRendering();
   }
 
   void Select::onClick(sf::Mouse::Button button, const sf::Vector2f& mouse) {
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2014, Julien Bernard
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#include <ui/SoftwareRenderer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <ui/RenderVisitor.h>
+
+namespace ui {
+
+  static uint32_t packColor(const sf::Color& color) {
+    // keep the bytes in the RGBA order in memory, whatever the endianness
+    uint8_t bytes[4] = { color.r, color.g, color.b, color.a };
+    uint32_t pixel;
+    std::memcpy(&pixel, bytes, sizeof pixel);
+    return pixel;
+  }
+
+  static sf::Color unpackColor(uint32_t pixel) {
+    uint8_t bytes[4];
+    std::memcpy(bytes, &pixel, sizeof pixel);
+    return sf::Color(bytes[0], bytes[1], bytes[2], bytes[3]);
+  }
+
+  static uint8_t blendChannel(uint8_t src, uint8_t dst, unsigned alpha) {
+    return static_cast<uint8_t>((src * alpha + dst * (255 - alpha) + 127) / 255);
+  }
+
+  SoftwareRenderer::SoftwareRenderer(unsigned width, unsigned height)
+  : m_width(0)
+  , m_height(0)
+  , m_cache_depth(0)
+  , m_offset(0.0f, 0.0f)
+  {
+    resize(width, height);
+  }
+
+  void SoftwareRenderer::resize(unsigned width, unsigned height) {
+    m_width = width;
+    m_height = height;
+    m_pixels.assign(static_cast<std::size_t>(width) * height, 0);
+  }
+
+  sf::Color SoftwareRenderer::getPixel(unsigned x, unsigned y) const {
+    return unpackColor(m_pixels[static_cast<std::size_t>(y) * m_width + x]);
+  }
+
+  void SoftwareRenderer::clear(const sf::Color& color) {
+    std::fill(m_pixels.begin(), m_pixels.end(), packColor(color));
+  }
+
+  void SoftwareRenderer::draw(Widget& widget) {
+    // the widgets outside the buffer are not visited
+    sf::FloatRect bounds(0, 0, static_cast<float>(m_width), static_cast<float>(m_height));
+
+    m_commands.clear();
+    RenderVisitor visitor(m_commands);
+    visitor.setClip(&bounds);
+    widget.accept(visitor);
+    draw(m_commands);
+  }
+
+  void SoftwareRenderer::draw(const RenderCommandList& commands) {
+    for (auto& command : commands) {
+      switch (command.type) {
+        case RenderCommandType::RECTANGLE:
+          fillRectangle(move(command.geometry), command.color);
+          break;
+        case RenderCommandType::OUTLINE:
+          drawOutline(move(command.geometry), command.color);
+          break;
+        case RenderCommandType::TEXT:
+          // no font rasterization
+          break;
+        case RenderCommandType::CACHE: {
+          // there is no texture to keep, so draw the content, where the
+          // command is (the bin may be in a scroll area)
+          Bin& widget = *static_cast<Bin *>(command.widget);
+          sf::FloatRect geometry = widget.getGeometry();
+
+          // the command lists are kept from one frame to the next, one for
+          // each level of nesting as the content is drawn recursively
+          if (m_cache_depth == m_cache_commands.size()) {
+            m_cache_commands.emplace_back(new RenderCommandList);
+          }
+
+          RenderCommandList& content = *m_cache_commands[m_cache_depth];
+          content.clear();
+
+          RenderVisitor visitor(content);
+          visitor.visitBinContent(widget);
+
+          sf::Vector2f saved_offset = m_offset;
+          m_offset += sf::Vector2f(command.geometry.left - geometry.left, command.geometry.top - geometry.top);
+          m_cache_depth++;
+          draw(content);
+          m_cache_depth--;
+          m_offset = saved_offset;
+          break;
+        }
+        case RenderCommandType::CLIP_BEGIN: {
+          sf::FloatRect clip = move(command.geometry);
+
+          if (!m_clips.empty()) {
+            // an empty intersection clips everything
+            m_clips.back().intersects(clip, clip);
+          }
+
+          m_clips.push_back(clip);
+          break;
+        }
+        case RenderCommandType::CLIP_END:
+          m_clips.pop_back();
+          break;
+      }
+    }
+  }
+
+  static long roundCoordinate(float coordinate) {
+    // the pixel is covered if its center is covered
+    return static_cast<long>(std::floor(coordinate + 0.5f));
+  }
+
+  void SoftwareRenderer::fillRectangle(const sf::FloatRect& geometry, const sf::Color& color) {
+    if (color.a == 0) {
+      return;
+    }
+
+    long left = std::max(roundCoordinate(geometry.left), 0L);
+    long top = std::max(roundCoordinate(geometry.top), 0L);
+    long right = std::min(roundCoordinate(geometry.left + geometry.width), static_cast<long>(m_width));
+    long bottom = std::min(roundCoordinate(geometry.top + geometry.height), static_cast<long>(m_height));
+
+    if (!m_clips.empty()) {
+      const sf::FloatRect& clip = m_clips.back();
+      left = std::max(left, roundCoordinate(clip.left));
+      top = std::max(top, roundCoordinate(clip.top));
+      right = std::min(right, roundCoordinate(clip.left + clip.width));
+      bottom = std::min(bottom, roundCoordinate(clip.top + clip.height));
+    }
+
+    if (left >= right || top >= bottom) {
+      return;
+    }
+
+    std::size_t length = static_cast<std::size_t>(right - left);
+
+    for (long y = top; y < bottom; ++y) {
+      fillSpan(m_pixels.data() + static_cast<std::size_t>(y) * m_width + left, length, color);
+    }
+  }
+
+  void SoftwareRenderer::drawOutline(const sf::FloatRect& geometry, const sf::Color& color) {
+    // same as a sf::RectangleShape with an outline thickness of 1
+    static constexpr float thickness = 1.0f;
+
+    float left = geometry.left - thickness;
+    float top = geometry.top - thickness;
+    float right = geometry.left + geometry.width;
+    float bottom = geometry.top + geometry.height;
+    float outer_width = geometry.width + 2 * thickness;
+
+    fillRectangle({ left, top, outer_width, thickness }, color);
+    fillRectangle({ left, bottom, outer_width, thickness }, color);
+    fillRectangle({ left, geometry.top, thickness, geometry.height }, color);
+    fillRectangle({ right, geometry.top, thickness, geometry.height }, color);
+  }
+
+  sf::FloatRect SoftwareRenderer::move(const sf::FloatRect& geometry) const {
+    return { geometry.left + m_offset.x, geometry.top + m_offset.y, geometry.width, geometry.height };
+  }
+
+  void SoftwareRenderer::fillSpan(uint32_t *span, std::size_t length, const sf::Color& color) {
+    if (color.a == 255) {
+      // a plain std::fill_n over the 32-bit pixels
+      std::fill_n(span, length, packColor(color));
+      return;
+    }
+
+    for (std::size_t i = 0; i < length; ++i) {
+      sf::Color dst = unpackColor(span[i]);
+      dst.r = blendChannel(color.r, dst.r, color.a);
+      dst.g = blendChannel(color.g, dst.g, color.a);
+      dst.b = blendChannel(color.b, dst.b, color.a);
+      dst.a = static_cast<uint8_t>(color.a + dst.a * (255 - color.a) / 255);
+      span[i] = packColor(dst);
+    }
+  }
+
+}
@@ -23,8 +23,10 @@
 namespace ui {
 
   Stack::~Stack() {
+    // no invalidation, the hierarchy is being destroyed
     while (hasChildren()) {
-      removeChild();
+      delete m_children.top();
+      m_children.pop();
     }
   }
 
@@ -39,11 +41,25 @@ namespace ui {
   }
 
   void Stack::layoutRequest() {
-    // TODO
+    if (!hasChildren()) {
+      return;
+    }
+
+    getTopChild()->updateLayoutRequest();
+
+    getVerticalGeometry().hint = getTopChild()->getVerticalGeometry().hint;
+    getHorizontalGeometry().hint = getTopChild()->getHorizontalGeometry().hint;
   }
 
   void Stack::layoutAllocation() {
-    // TODO
+    if (!hasChildren()) {
+      return;
+    }
+
+    computeGeometry(getVerticalGeometry(), getTopChild()->getVerticalGeometry());
+    computeGeometry(getHorizontalGeometry(), getTopChild()->getHorizontalGeometry());
+
+    getTopChild()->updateLayoutAllocation();
   }
 
   void Stack::accept(WidgetVisitor& visitor) {
@@ -15,6 +15,7 @@
  */
 #include <ui/Table.h>
 
+#include <algorithm>
 #include <cassert>
 #include <numeric>
 
@@ -32,9 +33,59 @@ namespace ui {
     }
   }
 
+  static constexpr std::size_t NoIndex = static_cast<std::size_t>(-1);
+
+  static std::size_t findGeometry(const std::vector<Geometry>& geometries, float position) {
+    auto it = std::upper_bound(geometries.begin(), geometries.end(), position, [](float value, const Geometry& g) {
+      return value < g.start;
+    });
+
+    if (it == geometries.begin()) {
+      return NoIndex;
+    }
+
+    --it;
+
+    if (position >= it->start + it->size) {
+      // in a gap
+      return NoIndex;
+    }
+
+    return it - geometries.begin();
+  }
+
+  void Table::onClick(sf::Mouse::Button button, const sf::Vector2f& mouse) {
+    bool layout_done = !isLayoutRequestNeeded() && !isLayoutAllocationNeeded();
+
+    if (!layout_done) {
+      // the geometries of the rows and columns are not up to date
+      Container::onClick(button, mouse);
+      return;
+    }
+
+    size_type r = findGeometry(m_rows_geometry, mouse.y);
+    size_type c = findGeometry(m_cols_geometry, mouse.x);
+
+    if (r == NoIndex || c == NoIndex) {
+      return;
+    }
+
+    size_type index = r * m_cols_geometry.size() + c;
+
+    if (index >= getChildrenCount()) {
+      return;
+    }
+
+    Widget *child = ithChild(index);
+
+    if (child->getGeometry().contains(mouse)) {
+      child->onClick(button, mouse);
+    }
+  }
+
   void Table::layoutRequest() {
     for (auto child : *this) {
-      child->layoutRequest();
+      child->updateLayoutRequest();
     }
 
     size_type nrows = m_rows;
@@ -117,7 +168,7 @@ namespace ui {
       computeGeometry(m_rows_geometry[r], child->getVerticalGeometry());
       computeGeometry(m_cols_geometry[c], child->getHorizontalGeometry());
 
-      child->layoutAllocation();
+      child->updateLayoutAllocation();
 
       c++;
       if (c == ncols) {
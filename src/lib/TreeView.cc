@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2014, Julien Bernard
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#include <ui/TreeView.h>
+
+#include <cassert>
+
+namespace ui {
+
+  constexpr TreeModel::Node TreeModel::Root;
+
+  TreeModel::~TreeModel() {
+  }
+
+  TreeView::TreeView(TreeModel& model, float row_height)
+  : ListView(*this, row_height)
+  , m_model(model)
+  {
+    invalidateNodes();
+  }
+
+  void TreeView::expand(std::size_t row) {
+    assert(row < m_entries.size());
+
+    if (m_entries[row].expanded || !m_model.hasChildren(m_entries[row].node)) {
+      return;
+    }
+
+    m_children.clear(); // keep the capacity
+    m_model.getChildren(m_entries[row].node, m_children);
+
+    Entry entry;
+    entry.depth = m_entries[row].depth + 1;
+    entry.expanded = false;
+
+    m_entries[row].expanded = true;
+    m_entries.insert(m_entries.begin() + row + 1, m_children.size(), entry);
+
+    for (std::size_t i = 0; i < m_children.size(); ++i) {
+      m_entries[row + 1 + i].node = m_children[i];
+    }
+
+    // the focused row moves down with the following rows
+    std::size_t focused = getFocusedRow();
+
+    if (focused != NoRow && focused > row) {
+      setFocusedRow(focused + m_children.size());
+    }
+
+    // the rows before this node are still the same
+    invalidateRows(row);
+  }
+
+  void TreeView::collapse(std::size_t row) {
+    assert(row < m_entries.size());
+
+    if (!m_entries[row].expanded) {
+      return;
+    }
+
+    std::size_t end = findSubtreeEnd(row);
+
+    // the focus in the collapsed subtree moves to the collapsed node
+    std::size_t focused = getFocusedRow();
+
+    if (focused != NoRow && focused > row) {
+      setFocusedRow(focused < end ? row : focused - (end - row - 1));
+    }
+
+    m_entries[row].expanded = false;
+    m_entries.erase(m_entries.begin() + row + 1, m_entries.begin() + end);
+
+    invalidateRows(row);
+  }
+
+  void TreeView::toggle(std::size_t row) {
+    if (isExpanded(row)) {
+      collapse(row);
+    } else {
+      expand(row);
+    }
+  }
+
+  void TreeView::invalidateNodes() {
+    m_children.clear();
+    m_model.getChildren(TreeModel::Root, m_children);
+
+    m_entries.clear();
+
+    for (auto node : m_children) {
+      m_entries.push_back({ node, 0, false });
+    }
+
+    // the focused node may not be shown anymore
+    setFocusedRow(NoRow);
+
+    invalidateRows();
+  }
+
+  std::size_t TreeView::getRowCount() const {
+    return m_entries.size();
+  }
+
+  Widget *TreeView::createRow() {
+    return m_model.createRow();
+  }
+
+  void TreeView::updateRow(Widget& widget, std::size_t index, bool focused) {
+    const Entry& entry = m_entries[index];
+    m_model.updateRow(widget, index, entry.node, entry.depth, entry.expanded, focused);
+  }
+
+  std::size_t TreeView::findSubtreeEnd(std::size_t row) const {
+    // the descendants are the following rows with a greater depth
+    unsigned depth = m_entries[row].depth;
+    std::size_t end = row + 1;
+
+    while (end < m_entries.size() && m_entries[end].depth > depth) {
+      ++end;
+    }
+
+    return end;
+  }
+
+}
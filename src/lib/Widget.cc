@@ -17,6 +17,8 @@
 
 namespace ui {
 
+  static std::size_t g_layout_allocation_count = 0;
+
   Widget::~Widget() {
   }
 
@@ -32,4 +34,91 @@ namespace ui {
     // nothing by default
   }
 
+  void Widget::invalidateFocus() {
+    if (m_parent != nullptr) {
+      m_parent->invalidateFocus();
+    }
+  }
+
+  void Widget::childFocusChanged(Widget& child, Leaf& leaf, bool focused) {
+    if (m_parent != nullptr) {
+      m_parent->childFocusChanged(*this, leaf, focused);
+    }
+  }
+
+  void Widget::invalidateRendering() {
+    for (Widget *widget = this; widget != nullptr; widget = widget->m_parent) {
+      ++widget->m_rendering_version;
+    }
+
+    addOwnDamage(getGeometry());
+  }
+
+  void Widget::addOwnDamage(const sf::FloatRect& rectangle) {
+    // the geometry of a widget is in the coordinates of its parent
+    if (m_parent != nullptr) {
+      m_parent->addDamage(rectangle);
+    } else {
+      addDamage(rectangle);
+    }
+  }
+
+  void Widget::addDamage(const sf::FloatRect& rectangle) {
+    if (m_parent != nullptr) {
+      m_parent->addDamage(rectangle);
+    }
+  }
+
+  void Widget::invalidateLayout() {
+    Widget *widget = this;
+
+    while (widget != nullptr) {
+      bool already_needed = widget->m_layout_request_needed;
+
+      widget->m_layout_request_needed = true;
+      widget->m_layout_allocation_needed = true;
+
+      if (already_needed) {
+        // the ancestors have already been invalidated
+        return;
+      }
+
+      widget = widget->m_parent;
+    }
+  }
+
+  void Widget::updateLayoutRequest() {
+    if (!m_layout_request_needed) {
+      return;
+    }
+
+    layoutRequest();
+    m_layout_request_needed = false;
+  }
+
+  void Widget::updateLayoutAllocation() {
+    sf::FloatRect geometry = getGeometry();
+
+    if (!m_layout_allocation_needed && geometry == m_allocated_geometry) {
+      return;
+    }
+
+    layoutAllocation();
+
+    // the widget must be drawn again at its previous place and at its new
+    // place, if it has moved
+    if (m_allocated_geometry != geometry) {
+      addOwnDamage(m_allocated_geometry);
+      invalidateRendering();
+    }
+
+    m_allocated_geometry = geometry;
+    m_layout_allocation_needed = false;
+    ++g_layout_allocation_count;
+  }
+
+  std::size_t Widget::getLayoutAllocationCount() {
+    return g_layout_allocation_count;
+  }
+
 }
@@ -33,11 +33,11 @@ namespace ui {
     // nothing by default
   }
 
-  void WidgetVisitor::visitLabel(Label& widget) {
+  void WidgetVisitor::visitForm(Form& widget) {
     // nothing by default
   }
 
-  void WidgetVisitor::visitForm(Form& widget) {
+  void WidgetVisitor::visitGridView(GridView& widget) {
     // nothing by default
   }
 
@@ -45,6 +45,18 @@ namespace ui {
     // nothing by default
   }
 
+  void WidgetVisitor::visitLabel(Label& widget) {
+    // nothing by default
+  }
+
+  void WidgetVisitor::visitListView(ListView& widget) {
+    // nothing by default
+  }
+
+  void WidgetVisitor::visitScrollArea(ScrollArea& widget) {
+    // nothing by default
+  }
+
   void WidgetVisitor::visitSelect(Select& widget) {
     // nothing by default
   }
@@ -67,20 +79,84 @@ namespace ui {
 
   void WidgetVisitor::visitBinChild(Bin& widget) {
     if (widget.hasChild()) {
-      widget.getChild()->accept(*this);
+      visitChild(*widget.getChild());
     }
   }
 
   void WidgetVisitor::visitContainerChildren(Container& widget) {
     for (auto child : widget) {
-      child->accept(*this);
+      visitChild(*child);
+    }
+  }
+
+  void WidgetVisitor::visitGridViewCells(GridView& widget) {
+    for (auto cell : widget) {
+      visitChild(*cell);
+    }
+
+    if (widget.getHiddenFocusedCell() != nullptr) {
+      // the focused cell is scrolled out
+      ++m_culled_count;
+    }
+  }
+
+  void WidgetVisitor::visitListViewRows(ListView& widget) {
+    for (auto row : widget) {
+      visitChild(*row);
+    }
+
+    if (widget.getHiddenFocusedRow() != nullptr) {
+      // the focused row is scrolled out
+      ++m_culled_count;
+    }
+  }
+
+  void WidgetVisitor::visitScrollAreaChild(ScrollArea& widget) {
+    if (!widget.hasChild()) {
+      return;
     }
+
+    sf::FloatRect clip = widget.getGeometry();
+
+    if (m_clip != nullptr && !m_clip->intersects(clip, clip)) {
+      ++m_culled_count;
+      return;
+    }
+
+    // the clip and the descendants are now in the coordinates of the content
+    const sf::Vector2f& offset = widget.getOffset();
+    clip.left += offset.x;
+    clip.top += offset.y;
+
+    const sf::FloatRect *saved_clip = m_clip;
+    sf::Vector2f saved_translation = m_translation;
+
+    m_clip = &clip;
+    m_translation += offset;
+
+    visitChild(*widget.getChild());
+
+    m_clip = saved_clip;
+    m_translation = saved_translation;
   }
 
   void WidgetVisitor::visitStackTopChild(Stack& widget) {
     if (widget.hasChildren()) {
-      widget.getTopChild()->accept(*this);
+      visitChild(*widget.getTopChild());
+    }
+  }
+
+  bool WidgetVisitor::isCulled(const Widget& widget) const {
+    return !m_clip->intersects(widget.getGeometry());
+  }
+
+  void WidgetVisitor::visitChild(Widget& widget) {
+    if (m_clip != nullptr && isCulled(widget)) {
+      ++m_culled_count;
+      return;
     }
+
+    widget.accept(*this);
   }
 
 }